@@ -0,0 +1,287 @@
+#include "batch_check.h"
+
+#include <bitset>
+#include <cstring>
+#include <stdexcept>
+
+namespace inpch {
+
+    check_spec::check_spec(const int &length, const base_type &base)
+            : kind(base_kind), length(length), base(base) {
+        switch (base) {
+            case not_a_number:
+            case decimal:
+            case octal:
+            case hexadecimal:
+            case binary:
+                return;
+            default:
+                throw WrongBaseException();
+        }
+    }
+
+    check_spec::check_spec(const language &lang) : kind(language_kind), lang(lang) {
+        if (lang < rus || lang > EnG) throw WrongLanguageException();
+    }
+
+    check_spec::check_spec(const std::regex &regex) : kind(regex_kind), regex(&regex) {}
+
+    check_spec::check_spec(const regex_pattern &pattern) : kind(regex_kind), regex(&pattern.get()) {}
+
+    check_spec::check_spec(const dfa_pattern &pattern) : kind(dfa_kind), automaton(&pattern.get()) {}
+
+    check_spec::check_spec(const date_format &format) : kind(date_kind), dates(format) {}
+
+    bool check_spec::operator()(std::string_view input) const noexcept {
+        switch (kind) {
+            case base_kind:
+                if (input.empty()) return false;
+                if (length != any_length && input.size() != static_cast<std::size_t>(length)) return false;
+                switch (base) {
+                    case decimal:
+                        return is_decimal(input);
+                    case octal:
+                        return is_octal(input);
+                    case hexadecimal:
+                        return is_hexadecimal(input);
+                    case binary:
+                        return is_binary(input);
+                    default:
+                        return true;
+                }
+            case language_kind:
+                return !input.empty() && first_not_of_language(input.data(), input.size(), lang) == input.size();
+            case regex_kind:
+                try {
+                    return std::regex_match(input.begin(), input.end(), *regex);
+                } catch (...) {
+                    return false;
+                }
+            case dfa_kind:
+                return automaton->match(input);
+            case date_kind:
+                return is_date(input, dates);
+        }
+        return false;
+    }
+
+    result_cache::spec_id check_spec::key() const noexcept {
+        switch (kind) {
+            case regex_kind:
+                return result_cache::spec_of(regex);
+            case dfa_kind:
+                return result_cache::spec_of(automaton);
+            default: {
+                const std::int64_t fields[] = {kind, length, base, lang, static_cast<std::int64_t>(dates)};
+                return result_cache::spec_of_text(std::string_view(reinterpret_cast<const char *>(fields),
+                                                                   sizeof(fields)));
+            }
+        }
+    }
+
+    std::size_t result_bitmap::count() const noexcept {
+        std::size_t total = 0;
+        // Карты filter_range плотные, поэтому не по одному биту
+        for (std::uint64_t word: bits) total += std::bitset<64>(word).count();
+        return total;
+    }
+
+    namespace {
+
+        // Задача пула пишет только свои 64-битные слова карты, поэтому границы
+        // кусков выровнены на 64 элемента и синхронизация при записи не нужна
+        // accept(i) - прошёл ли проверку элемент i
+        template<class Accept>
+        result_bitmap run_batch(std::size_t count, const batch_options &options, Accept &&accept) {
+            result_bitmap result(count);
+            auto &words = result.words();
+
+            auto check_range = [&](std::size_t first, std::size_t last) {
+                for (std::size_t w = first / 64; w * 64 < last; ++w) {
+                    std::uint64_t word = 0;
+                    std::size_t end = std::min(last, (w + 1) * 64);
+                    for (std::size_t i = w * 64; i < end; ++i) {
+                        word |= static_cast<std::uint64_t>(accept(i)) << (i % 64);
+                    }
+                    words[w] = word;
+                }
+            };
+
+            thread_pool &pool = options.pool ? *options.pool : default_thread_pool();
+            if (count < options.parallel_threshold || pool.concurrency() == 1) {
+                check_range(0, count);
+                return result;
+            }
+
+            std::size_t chunk = std::max<std::size_t>(64, (options.chunk_size + 63) / 64 * 64);
+            std::size_t chunks = (count + chunk - 1) / chunk;
+            pool.parallel_for(chunks, [&](std::size_t c) {
+                check_range(c * chunk, std::min(count, (c + 1) * chunk));
+            });
+            return result;
+        }
+
+        // Проверка элемента с кэшем или без; в кэш попадает только итог, поэтому
+        // отказ записывается как no_match
+        template<class Item>
+        result_bitmap check_items(std::size_t count, const check_spec &spec, const batch_options &options,
+                                  Item &&item) {
+            if (!options.cache) {
+                return run_batch(count, options, [&](std::size_t i) { return spec(item(i)); });
+            }
+            result_cache &cache = *options.cache;
+            const result_cache::spec_id key = spec.key();
+            return run_batch(count, options, [&](std::size_t i) {
+                std::string_view input = item(i);
+                return cache.get_or_check(key, input, [&]() noexcept -> check_result {
+                    return {input.size(), spec(input) ? check_error::none : check_error::no_match};
+                }).ok();
+            });
+        }
+
+        // Принятые значения копируются в пул после проверки, одним проходом,
+        // чтобы порядок не зависел от задач пула
+        template<class Item>
+        result_bitmap run_checks(std::size_t count, const check_spec &spec, const batch_options &options,
+                                 Item &&item) {
+            result_bitmap result = check_items(count, spec, options, item);
+            if (options.accepted) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (result.test(i)) options.accepted->append(item(i));
+                }
+            }
+            return result;
+        }
+
+    } // namespace
+
+    result_bitmap check_batch(const std::string_view *inputs, std::size_t count, const check_spec &spec,
+                              const batch_options &options) {
+        return run_checks(count, spec, options, [inputs](std::size_t i) { return inputs[i]; });
+    }
+
+    result_bitmap check_batch(const std::vector<std::string_view> &inputs, const check_spec &spec,
+                              const batch_options &options) {
+        return check_batch(inputs.data(), inputs.size(), spec, options);
+    }
+
+#ifdef INPCH_HAS_SPAN
+    result_bitmap check_batch(std::span<const std::string_view> inputs, const check_spec &spec,
+                              const batch_options &options) {
+        return check_batch(inputs.data(), inputs.size(), spec, options);
+    }
+#endif
+
+    result_bitmap check_batch(const char *bytes, const std::size_t *offsets, std::size_t count,
+                              const check_spec &spec, const batch_options &options) {
+        return run_checks(count, spec, options, [bytes, offsets](std::size_t i) {
+            return std::string_view(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+        });
+    }
+
+    namespace {
+
+        // Разбор и запись значения в одном проходе; элементы задачи пула пишут
+        // только свои ячейки epoch_seconds
+        template<class Item>
+        result_bitmap run_dates(std::size_t count, date_format format, std::int64_t *epoch_seconds,
+                                const batch_options &options, Item &&item) {
+            return run_batch(count, options, [&](std::size_t i) {
+                date_result parsed = parse_date(item(i), format);
+                bool ok = parsed.error == check_error::none;
+                if (epoch_seconds) epoch_seconds[i] = ok ? parsed.value.epoch_seconds() : 0;
+                return ok;
+            });
+        }
+
+    } // namespace
+
+    result_bitmap parse_dates(const std::string_view *inputs, std::size_t count, date_format format,
+                              std::int64_t *epoch_seconds, const batch_options &options) {
+        return run_dates(count, format, epoch_seconds, options, [inputs](std::size_t i) { return inputs[i]; });
+    }
+
+    result_bitmap parse_dates(const std::vector<std::string_view> &inputs, date_format format,
+                              std::int64_t *epoch_seconds, const batch_options &options) {
+        return parse_dates(inputs.data(), inputs.size(), format, epoch_seconds, options);
+    }
+
+    result_bitmap parse_dates(const char *bytes, const std::size_t *offsets, std::size_t count, date_format format,
+                              std::int64_t *epoch_seconds, const batch_options &options) {
+        return run_dates(count, format, epoch_seconds, options, [bytes, offsets](std::size_t i) {
+            return std::string_view(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+        });
+    }
+
+    namespace {
+
+        // Куски по chunk элементов, кратно 64, в вызывающем потоке или в пуле
+        template<class Run>
+        void for_chunks(std::size_t count, const batch_options &options, std::size_t &chunk, Run &&run) {
+            thread_pool &pool = options.pool ? *options.pool : default_thread_pool();
+            if (count < options.parallel_threshold || pool.concurrency() == 1) {
+                chunk = count;
+                run(0, 0, count);
+                return;
+            }
+            chunk = std::max<std::size_t>(64, (options.chunk_size + 63) / 64 * 64);
+            pool.parallel_for((count + chunk - 1) / chunk, [&](std::size_t c) {
+                run(c, c * chunk, std::min(count, (c + 1) * chunk));
+            });
+        }
+
+    } // namespace
+
+    template<class T>
+    result_bitmap filter_range(const T *values, std::size_t count, const T &left, const T &right, bool inside,
+                               nan_policy nan, const batch_options &options) {
+        result_bitmap result(count);
+        std::uint64_t *words = result.words().data();
+        std::size_t chunk;
+        for_chunks(count, options, chunk, [&](std::size_t, std::size_t first, std::size_t last) {
+            simd::range_mask(values + first, last - first, left, right, inside, nan == nan_policy::accept,
+                             words + first / 64);
+        });
+        return result;
+    }
+
+    template<class T>
+    std::vector<std::uint32_t> filter_range_indices(const T *values, std::size_t count, const T &left,
+                                                    const T &right, bool inside, nan_policy nan,
+                                                    const batch_options &options) {
+#ifdef INPCH_EXCEPTIONS
+        if (count > 0xFFFFFFFFu) throw std::length_error("filter_range_indices: too many values");
+#endif
+        // Кусок пишет номера в начало своей части out, затем части сдвигаются подряд
+        std::vector<std::uint32_t> out(count);
+        std::vector<std::size_t> found((count + 63) / 64 + 1);
+        std::size_t chunk;
+        for_chunks(count, options, chunk, [&](std::size_t c, std::size_t first, std::size_t last) {
+            found[c] = simd::range_indices(values + first, last - first, left, right, inside,
+                                           nan == nan_policy::accept, static_cast<std::uint32_t>(first),
+                                           out.data() + first);
+        });
+        std::size_t size = found[0];
+        for (std::size_t c = 1; chunk != 0 && c * chunk < count; ++c) {
+            std::memmove(out.data() + size, out.data() + c * chunk, found[c] * sizeof(std::uint32_t));
+            size += found[c];
+        }
+        out.resize(size);
+        return out;
+    }
+
+#define INPCH_FILTER_RANGE(T) \
+    template result_bitmap filter_range<T>(const T *, std::size_t, const T &, const T &, bool, nan_policy, \
+                                           const batch_options &); \
+    template std::vector<std::uint32_t> filter_range_indices<T>(const T *, std::size_t, const T &, const T &, bool, \
+                                                                nan_policy, const batch_options &);
+
+    INPCH_FILTER_RANGE(int)
+    INPCH_FILTER_RANGE(long)
+    INPCH_FILTER_RANGE(long long)
+    INPCH_FILTER_RANGE(float)
+    INPCH_FILTER_RANGE(double)
+
+#undef INPCH_FILTER_RANGE
+
+} // inpch
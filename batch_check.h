@@ -0,0 +1,168 @@
+#ifndef INPUTCHECK_BATCH_CHECK_H
+#define INPUTCHECK_BATCH_CHECK_H
+
+#include "input_check.h"
+#include "date_check.h"
+#include "string_pool.h"
+#include "thread_pool.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#define INPCH_HAS_SPAN 1
+#endif
+
+namespace inpch {
+
+    // Проверка, применяемая к каждому элементу пакета; те же варианты,
+    // что у конструкторов input_check, плюс шаблоны std::regex и ДКА.
+    // Шаблоны не копируются и должны жить дольше check_spec.
+    class check_spec {
+    public:
+        check_spec(const int &length = any_length, const base_type &base = not_a_number);
+
+        check_spec(const language &lang);
+
+        check_spec(const std::regex &regex);
+
+        // Компилирует шаблон сразу, если он ещё не собран
+        check_spec(const regex_pattern &pattern);
+
+        check_spec(const dfa_pattern &pattern);
+
+        check_spec(const date_format &format);
+
+        // Пустая строка не проходит ни одну проверку, как и в input_check
+        bool operator()(std::string_view input) const noexcept;
+
+        // Ключ проверки для result_cache: равен у check_spec с одинаковыми параметрами
+        // и одним и тем же шаблоном
+        result_cache::spec_id key() const noexcept;
+
+    private:
+        enum kind_type {
+            base_kind,
+            language_kind,
+            regex_kind,
+            dfa_kind,
+            date_kind
+        };
+
+        kind_type kind;
+        int length = any_length;
+        base_type base = not_a_number;
+        language lang = eng;
+        date_format dates = date_format::any;
+        const std::regex *regex = nullptr;
+        const dfa *automaton = nullptr;
+    };
+
+    // Битовая карта результатов: бит i установлен, если элемент i прошёл проверку
+    class result_bitmap {
+    public:
+        explicit result_bitmap(std::size_t size = 0) : bits((size + 63) / 64), length(size) {}
+
+        std::size_t size() const noexcept { return length; }
+
+        bool test(std::size_t i) const noexcept { return (bits[i / 64] >> (i % 64)) & 1u; }
+
+        bool operator[](std::size_t i) const noexcept { return test(i); }
+
+        void set(std::size_t i, bool value) noexcept {
+            if (value) {
+                bits[i / 64] |= std::uint64_t{1} << (i % 64);
+            } else {
+                bits[i / 64] &= ~(std::uint64_t{1} << (i % 64));
+            }
+        }
+
+        // Число принятых элементов
+        std::size_t count() const noexcept;
+
+        const std::vector<std::uint64_t> &words() const noexcept { return bits; }
+
+        std::vector<std::uint64_t> &words() noexcept { return bits; }
+
+    private:
+        std::vector<std::uint64_t> bits;
+        std::size_t length;
+    };
+
+    struct batch_options {
+        // Пакеты меньше этого размера проверяются в вызывающем потоке
+        std::size_t parallel_threshold = 1u << 14;
+        // Элементов на задачу пула; округляется до кратного 64
+        std::size_t chunk_size = 4096;
+        // nullptr - default_thread_pool()
+        thread_pool *pool = nullptr;
+        // Кэш результатов для повторяющихся значений; nullptr - без кэша
+        result_cache *cache = nullptr;
+        // Куда check_batch дописывает принятые значения по порядку; пул не очищается,
+        // reset() перед пакетом - за вызывающим. nullptr - только карта результатов
+        string_pool *accepted = nullptr;
+    };
+
+    result_bitmap check_batch(const std::string_view *inputs, std::size_t count, const check_spec &spec,
+                              const batch_options &options = {});
+
+    result_bitmap check_batch(const std::vector<std::string_view> &inputs, const check_spec &spec,
+                              const batch_options &options = {});
+
+#ifdef INPCH_HAS_SPAN
+    result_bitmap check_batch(std::span<const std::string_view> inputs, const check_spec &spec,
+                              const batch_options &options = {});
+#endif
+
+    // Упакованный столбец: элемент i занимает bytes[offsets[i], offsets[i + 1])
+    result_bitmap check_batch(const char *bytes, const std::size_t *offsets, std::size_t count,
+                              const check_spec &spec, const batch_options &options = {});
+
+    // NaN в filter_range: reject - как check_range, NaN не проходит ни inside, ни outside
+    enum class nan_policy {
+        reject,
+        accept
+    };
+
+    // Столбец чисел: бит i установлен, если check_range(values[i], left, right, inside)
+    // проходит. Сравнения векторные (AVX2, AVX-512), T = int, long, long long, float, double
+    template<class T>
+    result_bitmap filter_range(const T *values, std::size_t count, const T &left, const T &right, bool inside = true,
+                               nan_policy nan = nan_policy::reject, const batch_options &options = {});
+
+    template<class T>
+    result_bitmap filter_range(const std::vector<T> &values, const T &left, const T &right, bool inside = true,
+                               nan_policy nan = nan_policy::reject, const batch_options &options = {}) {
+        return filter_range(values.data(), values.size(), left, right, inside, nan, options);
+    }
+
+    // То же, но номера прошедших элементов по возрастанию; count < 2^32
+    template<class T>
+    std::vector<std::uint32_t> filter_range_indices(const T *values, std::size_t count, const T &left, const T &right,
+                                                    bool inside = true, nan_policy nan = nan_policy::reject,
+                                                    const batch_options &options = {});
+
+    template<class T>
+    std::vector<std::uint32_t> filter_range_indices(const std::vector<T> &values, const T &left, const T &right,
+                                                    bool inside = true, nan_policy nan = nan_policy::reject,
+                                                    const batch_options &options = {}) {
+        return filter_range_indices(values.data(), values.size(), left, right, inside, nan, options);
+    }
+
+    // Столбец дат: бит i установлен, если элемент i - дата в формате format, и тогда
+    // epoch_seconds[i] - её значение (см. date_time::epoch_seconds), иначе 0.
+    // epoch_seconds может быть nullptr, если нужна только проверка.
+    result_bitmap parse_dates(const std::string_view *inputs, std::size_t count, date_format format,
+                              std::int64_t *epoch_seconds, const batch_options &options = {});
+
+    result_bitmap parse_dates(const std::vector<std::string_view> &inputs, date_format format,
+                              std::int64_t *epoch_seconds, const batch_options &options = {});
+
+    result_bitmap parse_dates(const char *bytes, const std::size_t *offsets, std::size_t count, date_format format,
+                              std::int64_t *epoch_seconds, const batch_options &options = {});
+
+} // inpch
+
+#endif //INPUTCHECK_BATCH_CHECK_H
@@ -0,0 +1,130 @@
+// Сравнение пропускной способности старых побайтовых циклов is_* с ядрами inpch::simd.
+//
+//   g++ -O2 -std=c++17 -I.. bench_base.cpp ../input_simd.cpp -o bench_base
+
+#include "input_simd.h"
+#include "bench_util.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Циклы в том виде, в каком они были в input_check.h
+    bool legacy_hexadecimal(const std::string &str) {
+        for (size_t i = 0; i < str.size(); ++i) {
+            char c = str[i];
+            if (!isxdigit(c)) return false;
+        }
+        return true;
+    }
+
+    bool legacy_binary(const std::string &str) {
+        for (size_t i = 0; i < str.size(); ++i) {
+            char c = str[i];
+            if (c != '0' && c != '1') return false;
+        }
+        return true;
+    }
+
+    bool legacy_decimal(const std::string &str) {
+        if (str.empty()) return false;
+        size_t start = 0;
+        if (str[0] == '+' || str[0] == '-') {
+            if (str.length() == 1) return false;
+            start = 1;
+        }
+        for (size_t i = start; i < str.size(); ++i) {
+            if (!isdigit(str[i])) return false;
+        }
+        return true;
+    }
+
+    bool legacy_octal(const std::string &str) {
+        if (str.empty()) return false;
+        for (size_t i = 0; i < str.size(); ++i) {
+            char c = str[i];
+            if (c < '0' || c > '7') return false;
+        }
+        return true;
+    }
+
+    std::vector<std::string> make_inputs(const char *alphabet, size_t length, size_t count) {
+        std::mt19937 rng(42);
+        std::string alpha(alphabet);
+        std::uniform_int_distribution<size_t> pick(0, alpha.size() - 1);
+        std::vector<std::string> inputs(count);
+        for (auto &s : inputs) {
+            s.resize(length);
+            for (auto &c : s) c = alpha[pick(rng)];
+        }
+        return inputs;
+    }
+
+    template<class F>
+    double measure_mbps(const std::vector<std::string> &inputs, F &&check) {
+        size_t bytes = 0;
+        for (const auto &s : inputs) bytes += s.size();
+
+        size_t accepted = 0, rounds = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{};
+        do {
+            for (const auto &s : inputs) accepted += check(s);
+            ++rounds;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < 0.2);
+
+        inpch::bench::do_not_optimize(accepted);
+        return static_cast<double>(bytes) * rounds / elapsed.count() / 1e6;
+    }
+
+    struct kernel {
+        const char *name;
+        const char *alphabet;
+        bool (*legacy)(const std::string &);
+        inpch::simd::byte_class cls;
+    };
+
+} // namespace
+
+int main() {
+    using namespace inpch::simd;
+
+    const kernel kernels[] = {
+            {"is_decimal",     "0123456789",             legacy_decimal,     byte_class::decimal},
+            {"is_hexadecimal", "0123456789abcdefABCDEF", legacy_hexadecimal, byte_class::hexadecimal},
+            {"is_octal",       "01234567",               legacy_octal,       byte_class::octal},
+            {"is_binary",      "01",                     legacy_binary,      byte_class::binary},
+    };
+    const size_t lengths[] = {8, 16, 32, 64, 256, 4096};
+    const isa levels[] = {isa::scalar, isa::sse2, isa::avx2};
+
+    std::printf("detected isa: %s\n", isa_name(detected_isa()));
+    std::printf("%-16s %6s %12s", "check", "length", "legacy MB/s");
+    for (isa level : levels) {
+        if (level <= detected_isa()) std::printf(" %12s", isa_name(level));
+    }
+    std::printf("\n");
+
+    for (const auto &k : kernels) {
+        for (size_t length : lengths) {
+            auto inputs = make_inputs(k.alphabet, length, (1u << 20) / length + 1);
+            std::printf("%-16s %6zu %12.0f", k.name, length, measure_mbps(inputs, k.legacy));
+            for (isa level : levels) {
+                if (level > detected_isa()) continue;
+                set_isa(level);
+                std::printf(" %12.0f", measure_mbps(inputs, [&k](const std::string &s) {
+                    return all_of(s.data(), s.size(), k.cls);
+                }));
+            }
+            std::printf("\n");
+            set_isa(detected_isa());
+        }
+    }
+    return 0;
+}
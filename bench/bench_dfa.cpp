@@ -0,0 +1,71 @@
+// Сравнение std::regex_match и ДКА из rgxp::dfa на шаблонах rgxp.
+//
+//   g++ -O2 -std=c++17 -I.. bench_dfa.cpp ../input_check.cpp ../input_simd.cpp ../input_dfa.cpp -o bench_dfa
+
+#include "input_check.h"
+#include "bench_util.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+    template<class F>
+    double measure_ns_per_item(const std::vector<std::string> &inputs, F &&check) {
+        size_t accepted = 0, rounds = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{};
+        do {
+            for (const auto &s : inputs) accepted += check(s);
+            ++rounds;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < 0.3);
+
+        inpch::bench::do_not_optimize(accepted);
+        return elapsed.count() * 1e9 / static_cast<double>(rounds * inputs.size());
+    }
+
+    struct pattern {
+        const char *name;
+        const std::regex &regex;
+        const inpch::dfa_pattern &automaton;
+        std::vector<std::string> inputs;
+    };
+
+} // namespace
+
+int main() {
+    std::vector<pattern> patterns = {
+            {"number",       rgxp::number,       rgxp::dfa::number,
+                    {"0", "42", "1234567890", "12345678901234567890", "12a", "", "-5"}},
+            {"email",        rgxp::email,        rgxp::dfa::email,
+                    {"user@example.com", "first.last+tag@mail.example.org", "no-at-sign.example.com",
+                            "a@b.c", "very.long.address.with.parts@sub.domain.example.co.uk"}},
+            {"url",          rgxp::url,          rgxp::dfa::url,
+                    {"https://www.example.com", "http://example.org", "ftp://example.com",
+                            "https://sub.domain.example.com/path", "http://a"}},
+            {"phone_number", rgxp::phone_number, rgxp::dfa::phone_number,
+                    {"+7 (999) 123-45-67", "89991234567", "+1-202-555-0143", "call me", "123"}},
+            {"hex",          rgxp::hex,          rgxp::dfa::hex,
+                    {"#a0f", "#00ff7f", "deadbe", "#12345", "#GGGGGG"}},
+    };
+
+    std::printf("%-14s %8s %14s %14s %10s\n", "pattern", "states", "regex ns/item", "dfa ns/item", "speedup");
+    for (const auto &p : patterns) {
+        auto build_start = std::chrono::steady_clock::now();
+        std::size_t states = p.automaton.get().state_count();
+        std::chrono::duration<double, std::milli> build = std::chrono::steady_clock::now() - build_start;
+
+        double regex_ns = measure_ns_per_item(p.inputs, [&p](const std::string &s) {
+            return std::regex_match(s, p.regex);
+        });
+        double dfa_ns = measure_ns_per_item(p.inputs, [&p](const std::string &s) {
+            return inpch::input_match(s, p.automaton);
+        });
+        std::printf("%-14s %8zu %14.1f %14.1f %9.1fx  (build %.2f ms)\n",
+                    p.name, states, regex_ns, dfa_ns, regex_ns / dfa_ns, build.count());
+    }
+    return 0;
+}
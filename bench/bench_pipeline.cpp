@@ -0,0 +1,119 @@
+// Масштабирование validation_pipeline с числом потоков проверки.
+//
+//   bench_pipeline [--count N] [--batch N] [--max-workers N]
+//
+// Подающий поток кладёт count адресов почты, главный поток забирает результаты.
+// Для каждой проверки (std::regex и ДКА) выводится пропускная способность при
+// 1, 2, 4, ... max-workers потоках и ускорение относительно одного потока;
+// строка "inline" - та же проверка в одном потоке без конвейера.
+
+#include "validation_pipeline.h"
+#include "bench_util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    std::vector<std::string> make_emails(std::size_t count) {
+        const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789._";
+        std::mt19937 rng(42);
+        std::vector<std::string> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string s;
+            for (std::size_t k = 8 + rng() % 16; k > 0; --k) s += alphabet[rng() % (sizeof(alphabet) - 1)];
+            s += i % 10 == 0 ? "@example" : "@example.com";
+            out.push_back(std::move(s));
+        }
+        return out;
+    }
+
+    // Элементов в секунду через конвейер
+    double run_pipeline(const std::vector<std::string> &inputs, const inpch::check_spec &spec,
+                        const inpch::pipeline_options &options) {
+        auto start = clock_type::now();
+        inpch::validation_pipeline pipeline(spec, options);
+        std::thread reader([&] {
+            for (const auto &s: inputs) pipeline.push(s);
+            pipeline.close();
+        });
+        std::size_t accepted = 0;
+        inpch::verdict v{};
+        while (pipeline.pop(v)) accepted += v.accepted;
+        reader.join();
+        std::chrono::duration<double> elapsed = clock_type::now() - start;
+        inpch::bench::do_not_optimize(accepted);
+        return static_cast<double>(inputs.size()) / elapsed.count();
+    }
+
+    double run_inline(const std::vector<std::string> &inputs, const inpch::check_spec &spec) {
+        auto start = clock_type::now();
+        std::size_t accepted = 0;
+        for (const auto &s: inputs) accepted += spec(s);
+        std::chrono::duration<double> elapsed = clock_type::now() - start;
+        inpch::bench::do_not_optimize(accepted);
+        return static_cast<double>(inputs.size()) / elapsed.count();
+    }
+
+    int usage() {
+        std::fputs("usage: bench_pipeline [--count N] [--batch N] [--max-workers N]\n", stderr);
+        return 2;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t count = 1u << 20;
+    std::size_t batch = 256;
+    std::size_t max_workers = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) return usage();
+        const char *value = argv[++i];
+        if (std::strcmp(argv[i - 1], "--count") == 0) {
+            count = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(argv[i - 1], "--batch") == 0) {
+            batch = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(argv[i - 1], "--max-workers") == 0) {
+            max_workers = std::strtoul(value, nullptr, 10);
+        } else {
+            return usage();
+        }
+    }
+    if (count == 0 || batch == 0 || max_workers == 0) return usage();
+
+    const std::vector<std::string> inputs = make_emails(count);
+    struct named_spec {
+        const char *name;
+        inpch::check_spec spec;
+    };
+    const named_spec specs[] = {
+            {"regex/email", inpch::check_spec(rgxp::email)},
+            {"dfa/email",   inpch::check_spec(rgxp::dfa::email)},
+    };
+
+    std::printf("%-12s %8s %14s %8s\n", "check", "workers", "Mitems/s", "speedup");
+    for (const auto &s: specs) {
+        std::printf("%-12s %8s %14.2f %8s\n", s.name, "inline", run_inline(inputs, s.spec) / 1e6, "");
+        double single = 0;
+        for (std::size_t workers = 1;; workers = std::min(workers * 2, max_workers)) {
+            inpch::pipeline_options options;
+            options.workers = workers;
+            options.batch_size = batch;
+            double rate = run_pipeline(inputs, s.spec, options);
+            if (workers == 1) single = rate;
+            std::printf("%-12s %8zu %14.2f %8.2f\n", s.name, workers, rate / 1e6, rate / single);
+            if (workers == max_workers) break;
+        }
+    }
+    return 0;
+}
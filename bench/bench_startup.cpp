@@ -0,0 +1,136 @@
+// Стоимость запуска процесса, который подключает input_check.h.
+//
+//   bench_startup [--runs N]
+//
+// Программа запускает саму себя runs раз в каждом режиме и выводит время запуска:
+//   idle   - процесс ничего не проверяет; шаблоны rgxp не компилируются
+//   email  - одна проверка input_match(.., rgxp::email): компилируется один шаблон
+//   eager  - компилируются все шаблоны rgxp, как это было при статической
+//            инициализации до перехода на regex_pattern
+// Затем в этом же процессе измеряется компиляция каждого шаблона std::regex.
+
+#include "input_check.h"
+#include "bench_util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <spawn.h>
+#include <sys/wait.h>
+#define INPCH_BENCH_SPAWN 1
+extern char **environ;
+#endif
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    struct named_pattern {
+        const char *name;
+        const inpch::regex_pattern &pattern;
+    };
+
+    const named_pattern patterns[] = {
+            {"contain_digit",   rgxp::contain_digit},
+            {"number",          rgxp::number},
+            {"email",           rgxp::email},
+            {"url",             rgxp::url},
+            {"date_YYYY_MM_DD", rgxp::date_YYYY_MM_DD},
+            {"date_any",        rgxp::date_any},
+            {"phone_number",    rgxp::phone_number},
+            {"hex",             rgxp::hex},
+    };
+
+    int child(const char *mode) {
+        if (std::strcmp(mode, "email") == 0) {
+            return inpch::input_match("user@example.com", rgxp::email) ? 0 : 1;
+        }
+        if (std::strcmp(mode, "eager") == 0) {
+            std::size_t marks = 0;
+            for (const auto &p: patterns) marks += p.pattern.get().mark_count();
+            return marks == 0 ? 1 : 0;
+        }
+        return 0;
+    }
+
+#ifdef INPCH_BENCH_SPAWN
+
+    // Время от запуска дочернего процесса до его завершения, мс
+    double launch_ms(const char *self, const char *mode) {
+        char *argv[] = {const_cast<char *>(self), const_cast<char *>("--child"), const_cast<char *>(mode), nullptr};
+        auto start = clock_type::now();
+        pid_t pid;
+        if (posix_spawn(&pid, self, nullptr, nullptr, argv, environ) != 0) return -1;
+        int status = 0;
+        waitpid(pid, &status, 0);
+        std::chrono::duration<double, std::milli> elapsed = clock_type::now() - start;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return -1;
+        return elapsed.count();
+    }
+
+#endif
+
+    int usage() {
+        std::fputs("usage: bench_startup [--runs N]\n", stderr);
+        return 2;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--child") == 0) return child(argv[2]);
+
+    std::size_t runs = 50;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            return usage();
+        }
+    }
+    if (runs == 0) return usage();
+
+#ifdef INPCH_BENCH_SPAWN
+    std::printf("%-8s %10s %10s %10s\n", "mode", "min ms", "median ms", "mean ms");
+    const char *modes[] = {"idle", "email", "eager"};
+    for (const char *mode: modes) {
+        std::vector<double> times;
+        for (std::size_t r = 0; r < runs; ++r) {
+            double ms = launch_ms(argv[0], mode);
+            if (ms < 0) {
+                std::fprintf(stderr, "bench_startup: cannot run %s\n", argv[0]);
+                return 1;
+            }
+            times.push_back(ms);
+        }
+        std::sort(times.begin(), times.end());
+        double mean = 0;
+        for (double t: times) mean += t;
+        mean /= static_cast<double>(times.size());
+        std::printf("%-8s %10.3f %10.3f %10.3f\n", mode, times.front(), times[times.size() / 2], mean);
+    }
+    std::printf("\n");
+#else
+    std::printf("process launch is measured only on POSIX systems\n\n");
+#endif
+
+    // Компиляция каждого шаблона заново, без учёта уже собранных regex_pattern
+    std::printf("%-16s %12s\n", "pattern", "compile us");
+    double total = 0;
+    for (const auto &p: patterns) {
+        auto start = clock_type::now();
+        std::regex compiled(p.pattern.pattern());
+        std::chrono::duration<double, std::micro> elapsed = clock_type::now() - start;
+        inpch::bench::do_not_optimize(compiled.mark_count());
+        total += elapsed.count();
+        std::printf("%-16s %12.1f\n", p.name, elapsed.count());
+    }
+    std::printf("%-16s %12.1f\n", "total", total);
+    return 0;
+}
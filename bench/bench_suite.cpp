@@ -0,0 +1,685 @@
+// Измерение всех проверок библиотеки с выводом результатов в JSON.
+//
+//   inputcheck_bench [--length N] [--count N] [--valid-ratio R] [--charset ascii|cyrillic]
+//                    [--min-time SEC] [--seed N] [--filter SUBSTR] [--output FILE]
+//
+// --length      длина сгенерированных строк (шаблоны фиксированной формы её игнорируют)
+// --count       число строк в наборе
+// --valid-ratio доля корректных строк; в остальные подставляется посторонний символ
+// --charset     откуда берутся посторонние символы и буквы текста: ASCII или кириллица
+//
+// Для каждой проверки выводятся байты/с, строки/с, среднее время вызова, а также
+// медиана и 99-й перцентиль времени вызова, измеренные по пачкам из batch_calls вызовов.
+// Без --output JSON печатается в stdout, с ним - в файл, а в stdout идёт таблица.
+
+#include "input_check.h"
+#include "batch_check.h"
+#include "record_schema.h"
+#include "static_check.h"
+#include "bench_util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr std::size_t batch_calls = 16;
+    constexpr std::size_t max_latency_samples = 1 << 16;
+
+    enum class charset {
+        ascii,
+        cyrillic
+    };
+
+    struct config {
+        std::size_t length = 32;
+        std::size_t count = 4096;
+        double valid_ratio = 0.9;
+        charset chars = charset::ascii;
+        double min_time = 0.2;
+        unsigned seed = 42;
+        std::string filter;
+        std::string output;
+    };
+
+    struct result {
+        std::string name;
+        std::size_t items;
+        std::size_t bytes;
+        double seconds;
+        double accepted;
+        double p50_ns;
+        double p99_ns;
+
+        double items_per_second() const { return static_cast<double>(items) / seconds; }
+
+        double bytes_per_second() const { return static_cast<double>(bytes) / seconds; }
+
+        double ns_per_call() const { return seconds * 1e9 / static_cast<double>(items); }
+    };
+
+    /* ---- Генерация входных данных ---- */
+
+    template<class S>
+    struct corpus {
+        std::vector<S> inputs;
+        std::size_t bytes = 0;
+    };
+
+    std::string utf8(char32_t ch) {
+        std::string out;
+        if (ch < 0x80) {
+            out += static_cast<char>(ch);
+        } else if (ch < 0x800) {
+            out += static_cast<char>(0xC0 | (ch >> 6));
+            out += static_cast<char>(0x80 | (ch & 0x3F));
+        } else {
+            out += static_cast<char>(0xE0 | (ch >> 12));
+            out += static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (ch & 0x3F));
+        }
+        return out;
+    }
+
+    std::string utf8(const std::wstring &s) {
+        std::string out;
+        for (wchar_t ch: s) out += utf8(static_cast<char32_t>(ch));
+        return out;
+    }
+
+    class generator {
+    public:
+        explicit generator(const config &cfg) : cfg(cfg), rng(cfg.seed) {}
+
+        std::size_t pick(std::size_t n) { return std::uniform_int_distribution<std::size_t>(0, n - 1)(rng); }
+
+        char pick(const char *alphabet) { return alphabet[pick(std::strlen(alphabet))]; }
+
+        wchar_t pick(const wchar_t *alphabet) { return alphabet[pick(std::wcslen(alphabet))]; }
+
+        std::string narrow(const char *alphabet, std::size_t length) {
+            std::string s(length, ' ');
+            for (auto &ch: s) ch = pick(alphabet);
+            return s;
+        }
+
+        std::wstring wide(const wchar_t *alphabet, std::size_t length) {
+            std::wstring s(length, L' ');
+            for (auto &ch: s) ch = pick(alphabet);
+            return s;
+        }
+
+        // Заменяет случайный символ посторонним из выбранного набора
+        void corrupt(std::string &s) {
+            std::size_t at = pick(s.size());
+            if (cfg.chars == charset::ascii) {
+                s[at] = pick(" !?*");
+            } else {
+                s.replace(at, 1, utf8(U'а' + static_cast<char32_t>(pick(32))));
+            }
+        }
+
+        void corrupt(std::wstring &s) {
+            std::size_t at = pick(s.size());
+            if (cfg.chars == charset::ascii) {
+                s[at] = pick(L" !?*");
+            } else {
+                s[at] = static_cast<wchar_t>(L'а' + pick(32));
+            }
+        }
+
+        // Собирает набор из cfg.count строк, доля valid_ratio из них не испорчена
+        template<class F>
+        auto make(F &&valid) -> corpus<decltype(valid())> {
+            corpus<decltype(valid())> out;
+            out.inputs.reserve(cfg.count);
+            std::bernoulli_distribution keep(cfg.valid_ratio);
+            for (std::size_t i = 0; i < cfg.count; ++i) {
+                auto s = valid();
+                if (!keep(rng) && !s.empty()) corrupt(s);
+                out.bytes += s.size() * sizeof(s[0]);
+                out.inputs.push_back(std::move(s));
+            }
+            return out;
+        }
+
+    private:
+        const config &cfg;
+        std::mt19937 rng;
+    };
+
+    /* ---- Измерение ---- */
+
+    template<class S, class F>
+    result measure(const std::string &name, const corpus<S> &data, const config &cfg, F &&check) {
+        std::size_t accepted = 0;
+        for (const auto &s: data.inputs) accepted += check(s) ? 1 : 0;
+        const double accepted_share = static_cast<double>(accepted) / static_cast<double>(data.inputs.size());
+
+        // Пропускная способность: целые проходы по набору, пока не наберётся min_time
+        std::size_t rounds = 0;
+        auto start = clock_type::now();
+        std::chrono::duration<double> elapsed{};
+        do {
+            for (const auto &s: data.inputs) accepted += check(s) ? 1 : 0;
+            ++rounds;
+            elapsed = clock_type::now() - start;
+        } while (elapsed.count() < cfg.min_time);
+
+        // Задержка: время пачки вызовов, делённое на их число
+        std::vector<double> samples;
+        std::size_t batches = std::min(max_latency_samples, std::max<std::size_t>(1, data.inputs.size() / batch_calls));
+        samples.reserve(batches);
+        for (std::size_t b = 0; b < batches; ++b) {
+            std::size_t first = (b * batch_calls) % data.inputs.size();
+            auto batch_start = clock_type::now();
+            for (std::size_t k = 0; k < batch_calls; ++k) {
+                accepted += check(data.inputs[(first + k) % data.inputs.size()]) ? 1 : 0;
+            }
+            std::chrono::duration<double, std::nano> batch = clock_type::now() - batch_start;
+            samples.push_back(batch.count() / batch_calls);
+        }
+        inpch::bench::do_not_optimize(accepted);
+
+        auto percentile = [&samples](double q) {
+            auto at = samples.begin() + static_cast<std::ptrdiff_t>(q * static_cast<double>(samples.size() - 1));
+            std::nth_element(samples.begin(), at, samples.end());
+            return *at;
+        };
+        double p50 = percentile(0.5);
+        double p99 = percentile(0.99);
+
+        return {name, rounds * data.inputs.size(), rounds * data.bytes, elapsed.count(), accepted_share, p50, p99};
+    }
+
+    /* ---- Вывод ---- */
+
+    const char *charset_name(charset chars) {
+        return chars == charset::ascii ? "ascii" : "cyrillic";
+    }
+
+    void write_json(std::FILE *out, const config &cfg, const std::vector<result> &results) {
+        std::fprintf(out, "{\n");
+        std::fprintf(out, "  \"config\": {\"length\": %zu, \"count\": %zu, \"valid_ratio\": %.4f, "
+                          "\"charset\": \"%s\", \"min_time\": %.3f, \"seed\": %u},\n",
+                     cfg.length, cfg.count, cfg.valid_ratio, charset_name(cfg.chars), cfg.min_time, cfg.seed);
+        std::fprintf(out, "  \"isa\": \"%s\",\n", inpch::simd::isa_name(inpch::simd::active_isa()));
+#ifdef __VERSION__
+        std::fprintf(out, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+        std::fprintf(out, "  \"results\": [\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const result &r = results[i];
+            std::fprintf(out, "    {\"name\": \"%s\", \"items\": %zu, \"bytes\": %zu, \"seconds\": %.6f, "
+                              "\"items_per_second\": %.1f, \"bytes_per_second\": %.1f, \"ns_per_call\": %.2f, "
+                              "\"p50_ns\": %.2f, \"p99_ns\": %.2f, \"accepted\": %.4f}%s\n",
+                         r.name.c_str(), r.items, r.bytes, r.seconds, r.items_per_second(), r.bytes_per_second(),
+                         r.ns_per_call(), r.p50_ns, r.p99_ns, r.accepted, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+
+    void write_table(std::FILE *out, const std::vector<result> &results) {
+        std::fprintf(out, "%-34s %12s %12s %10s %10s %10s %9s\n",
+                     "check", "MB/s", "Mitems/s", "ns/call", "p50 ns", "p99 ns", "accepted");
+        for (const auto &r: results) {
+            std::fprintf(out, "%-34s %12.1f %12.2f %10.1f %10.1f %10.1f %8.1f%%\n",
+                         r.name.c_str(), r.bytes_per_second() / 1e6, r.items_per_second() / 1e6,
+                         r.ns_per_call(), r.p50_ns, r.p99_ns, r.accepted * 100);
+        }
+    }
+
+    int usage() {
+        std::fputs("usage: inputcheck_bench [--length N] [--count N] [--valid-ratio R] "
+                   "[--charset ascii|cyrillic] [--min-time SEC] [--seed N] [--filter SUBSTR] "
+                   "[--output FILE]\n", stderr);
+        return 2;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    using namespace inpch;
+
+    config cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char *value = argv[++i];
+        if (arg == "--length") {
+            cfg.length = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--count") {
+            cfg.count = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--valid-ratio") {
+            cfg.valid_ratio = std::strtod(value, nullptr);
+        } else if (arg == "--charset") {
+            if (std::strcmp(value, "ascii") == 0) {
+                cfg.chars = charset::ascii;
+            } else if (std::strcmp(value, "cyrillic") == 0) {
+                cfg.chars = charset::cyrillic;
+            } else {
+                return usage();
+            }
+        } else if (arg == "--min-time") {
+            cfg.min_time = std::strtod(value, nullptr);
+        } else if (arg == "--seed") {
+            cfg.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--filter") {
+            cfg.filter = value;
+        } else if (arg == "--output") {
+            cfg.output = value;
+        } else {
+            return usage();
+        }
+    }
+    if (cfg.length == 0 || cfg.count == 0 || cfg.valid_ratio < 0 || cfg.valid_ratio > 1) return usage();
+
+    std::vector<result> results;
+    auto selected = [&cfg](const std::string &name) {
+        return cfg.filter.empty() || name.find(cfg.filter) != std::string::npos;
+    };
+    auto run = [&](const std::string &name, const auto &data, auto &&check) {
+        if (selected(name)) results.push_back(measure(name, data, cfg, check));
+    };
+
+    generator gen(cfg);
+    const std::size_t n = cfg.length;
+
+    /* ---- is_* ---- */
+
+    auto decimal_data = gen.make([&] { return gen.narrow("0123456789", n); });
+    auto hexadecimal_data = gen.make([&] { return gen.narrow("0123456789abcdefABCDEF", n); });
+    auto octal_data = gen.make([&] { return gen.narrow("01234567", n); });
+    auto binary_data = gen.make([&] { return gen.narrow("01", n); });
+
+    run("is_decimal", decimal_data, [](const std::string &s) { return is_decimal(s); });
+    run("is_hexadecimal", hexadecimal_data, [](const std::string &s) { return is_hexadecimal(s); });
+    run("is_octal", octal_data, [](const std::string &s) { return is_octal(s); });
+    run("is_binary", binary_data, [](const std::string &s) { return is_binary(s); });
+
+    auto decimal_wide = gen.make([&] { return gen.wide(L"0123456789", n); });
+    auto hexadecimal_wide = gen.make([&] { return gen.wide(L"0123456789abcdefABCDEF", n); });
+
+    run("is_decimal<wstring>", decimal_wide, [](const std::wstring &s) { return is_decimal(s); });
+    run("is_hexadecimal<wstring>", hexadecimal_wide, [](const std::wstring &s) { return is_hexadecimal(s); });
+
+    /* ---- input_check с языком ---- */
+
+    const wchar_t *rus_lower = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+    const wchar_t *rus_upper = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    const wchar_t *rus_mixed = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюяАБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    const char *eng_lower = "abcdefghijklmnopqrstuvwxyz";
+    const char *eng_upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    const char *eng_mixed = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    auto capitalized = [&](const wchar_t *upper, const wchar_t *lower) {
+        std::wstring s = gen.wide(lower, n);
+        s[0] = gen.pick(upper);
+        return s;
+    };
+    auto widen = [](const std::string &s) { return std::wstring(s.begin(), s.end()); };
+
+    struct language_case {
+        const char *name;
+        language lang;
+        corpus<std::wstring> data;
+    };
+    std::vector<language_case> languages;
+    languages.push_back({"rus", rus, gen.make([&] { return gen.wide(rus_lower, n); })});
+    languages.push_back({"RUS", RUS, gen.make([&] { return gen.wide(rus_upper, n); })});
+    languages.push_back({"Rus", Rus, gen.make([&] { return capitalized(rus_upper, rus_lower); })});
+    languages.push_back({"RuS", RuS, gen.make([&] { return gen.wide(rus_mixed, n); })});
+    languages.push_back({"eng", eng, gen.make([&] { return widen(gen.narrow(eng_lower, n)); })});
+    languages.push_back({"ENG", ENG, gen.make([&] { return widen(gen.narrow(eng_upper, n)); })});
+    languages.push_back({"Eng", Eng, gen.make([&] { return capitalized(L"ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+                                                                         L"abcdefghijklmnopqrstuvwxyz"); })});
+    languages.push_back({"EnG", EnG, gen.make([&] { return widen(gen.narrow(eng_mixed, n)); })});
+
+    for (const auto &c: languages) {
+        language lang = c.lang;
+        run(std::string("input_check<wstring>/") + c.name, c.data, [lang](const std::wstring &s) {
+            return input_check<std::wstring>(s, lang).is_correct();
+        });
+    }
+
+    struct narrow_language_case {
+        const char *name;
+        language lang;
+        corpus<std::string> data;
+    };
+    std::vector<narrow_language_case> narrow_languages;
+    narrow_languages.push_back({"rus", rus, gen.make([&] { return utf8(gen.wide(rus_lower, n)); })});
+    narrow_languages.push_back({"RUS", RUS, gen.make([&] { return utf8(gen.wide(rus_upper, n)); })});
+    narrow_languages.push_back({"Rus", Rus, gen.make([&] { return utf8(capitalized(rus_upper, rus_lower)); })});
+    narrow_languages.push_back({"RuS", RuS, gen.make([&] { return utf8(gen.wide(rus_mixed, n)); })});
+    narrow_languages.push_back({"eng", eng, gen.make([&] { return gen.narrow(eng_lower, n); })});
+    narrow_languages.push_back({"ENG", ENG, gen.make([&] { return gen.narrow(eng_upper, n); })});
+    narrow_languages.push_back({"Eng", Eng, gen.make([&] {
+        std::string s = gen.narrow(eng_lower, n);
+        s[0] = gen.pick(eng_upper);
+        return s;
+    })});
+    narrow_languages.push_back({"EnG", EnG, gen.make([&] { return gen.narrow(eng_mixed, n); })});
+
+    for (const auto &c: narrow_languages) {
+        language lang = c.lang;
+        run(std::string("input_check<string_view>/") + c.name, c.data, [lang](const std::string &s) {
+            return input_check_view(s, lang).is_correct();
+        });
+    }
+
+    /* ---- static_check: параметры на этапе компиляции ---- */
+
+    run("input_check<string_view>/decimal", decimal_data, [](const std::string &s) {
+        return input_check_view(s, any_length, decimal).is_correct();
+    });
+    run("static_check/decimal", decimal_data, [](const std::string &s) {
+        return static_check<policy::base<decimal>>::test(s);
+    });
+    run("static_check/hexadecimal", hexadecimal_data, [](const std::string &s) {
+        return static_check<policy::base<hexadecimal>>::test(s);
+    });
+    run("static_check/Eng", narrow_languages[6].data, [](const std::string &s) {
+        return static_check<policy::lang<Eng>>::test(s);
+    });
+    run("static_check/Rus", narrow_languages[2].data, [](const std::string &s) {
+        return static_check<policy::lang<Rus>>::test(s);
+    });
+
+    /* ---- content_type_of ---- */
+
+    // Текст с цифрами; для кириллицы узкая строка хранит UTF-8
+    auto text_narrow = gen.make([&] {
+        std::string s;
+        while (s.size() < n) {
+            if (cfg.chars == charset::ascii || gen.pick(4) == 0) {
+                s += gen.pick("abcdefghijklmnopqrstuvwxyz0123456789");
+            } else {
+                s += utf8(U'а' + static_cast<char32_t>(gen.pick(32)));
+            }
+        }
+        return s;
+    });
+    auto text_wide = gen.make([&] {
+        return gen.wide(cfg.chars == charset::ascii ? L"abcdefghijklmnopqrstuvwxyz0123456789"
+                                                     : L"абвгдежзийклмнопрстуфхцчшщъыьэюя0123456789", n);
+    });
+
+    run("content_type_of<string>", text_narrow, [](const std::string &s) {
+        return content_type_of(s) == content_type::text_with_numbers;
+    });
+    run("content_type_of<wstring>", text_wide, [](const std::wstring &s) {
+        return content_type_of(s) == content_type::text_with_numbers;
+    });
+    // Одни цифры: поиск букв проходит всю строку
+    run("content_type_of<wstring>/number", decimal_wide, [](const std::wstring &s) {
+        return content_type_of(s) == content_type::number;
+    });
+
+    /* ---- rgxp через input_match ---- */
+
+    auto digits = [&](std::size_t count) { return gen.narrow("0123456789", count); };
+    std::size_t body = n > 16 ? n - 16 : 1;
+
+    auto number_data = gen.make([&] { return digits(n); });
+    auto email_data = gen.make([&] {
+        return gen.narrow("abcdefghijklmnopqrstuvwxyz0123456789._", body) + "@example.com";
+    });
+    auto url_data = gen.make([&] {
+        return "https://www." + gen.narrow("abcdefghijklmnopqrstuvwxyz0123456789-", std::min<std::size_t>(body, 256)) +
+               ".com";
+    });
+    auto phone_data = gen.make([&] {
+        return "+7 (" + digits(3) + ") " + digits(3) + "-" + digits(2) + "-" + digits(2);
+    });
+    auto hex_data = gen.make([&] { return "#" + gen.narrow("0123456789abcdef", 6); });
+    auto date_data = gen.make([&] {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%04zu-%02zu-%02zu",
+                      1900 + gen.pick(200), 1 + gen.pick(12), 1 + gen.pick(28));
+        return std::string(buf);
+    });
+    auto date_any_data = gen.make([&] {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%02zu.%02zu.%04zu",
+                      1 + gen.pick(28), 1 + gen.pick(12), 1900 + gen.pick(200));
+        return std::string(buf);
+    });
+
+    struct pattern_case {
+        const char *name;
+        const std::regex &regex;
+        const dfa_pattern *automaton;
+        const corpus<std::string> &data;
+    };
+    const pattern_case patterns[] = {
+            {"contain_digit",   rgxp::contain_digit,   nullptr,                     number_data},
+            {"number",          rgxp::number,          &rgxp::dfa::number,          number_data},
+            {"email",           rgxp::email,           &rgxp::dfa::email,           email_data},
+            {"url",             rgxp::url,             &rgxp::dfa::url,             url_data},
+            {"date_YYYY_MM_DD", rgxp::date_YYYY_MM_DD, &rgxp::dfa::date_YYYY_MM_DD, date_data},
+            {"date_any",        rgxp::date_any,        nullptr,                     date_any_data},
+            {"phone_number",    rgxp::phone_number,    &rgxp::dfa::phone_number,    phone_data},
+            {"hex",             rgxp::hex,             &rgxp::dfa::hex,             hex_data},
+    };
+
+    for (const auto &p: patterns) {
+        const std::regex &regex = p.regex;
+        run(std::string("input_match/regex/") + p.name, p.data, [&regex](const std::string &s) {
+            return input_match(s, regex);
+        });
+        if (p.automaton) {
+            const dfa &automaton = p.automaton->get();
+            run(std::string("input_match/dfa/") + p.name, p.data, [&automaton](const std::string &s) {
+                return input_match(s, automaton);
+            });
+        }
+    }
+
+    /* ---- Кэш результатов: повторяющиеся значения ---- */
+
+    // count обращений к 512 разным адресам; частота адреса убывает с номером,
+    // как у популярных значений в реальном потоке
+    std::vector<std::string> hot_emails;
+    for (std::size_t i = 0; i < 512; ++i) {
+        hot_emails.push_back(gen.narrow("abcdefghijklmnopqrstuvwxyz0123456789._", 8 + gen.pick(16)) + "@example.com");
+    }
+    corpus<std::string> repeated_emails;
+    for (std::size_t i = 0; i < cfg.count; ++i) {
+        repeated_emails.inputs.push_back(hot_emails[std::min(gen.pick(hot_emails.size()), gen.pick(hot_emails.size()))]);
+        repeated_emails.bytes += repeated_emails.inputs.back().size();
+    }
+
+    result_cache email_cache;
+    run("result_cache/regex/email", repeated_emails, [](const std::string &s) {
+        return input_match(s, rgxp::email);
+    });
+    run("result_cache/regex/email+cache", repeated_emails, [&email_cache](const std::string &s) {
+        return input_match(s, rgxp::email, email_cache);
+    });
+    // Все значения разные: цена промаха и вставки поверх самой проверки
+    result_cache unique_cache({1u << 10, 16, 256, cache_admission::repeated});
+    run("result_cache/regex/email+cache/unique", email_data, [&unique_cache](const std::string &s) {
+        return input_match(s, rgxp::email, unique_cache);
+    });
+
+    /* ---- Фильтр диапазона по столбцу чисел ---- */
+
+    // Вход - блок из 1024 чисел в [-1000, 1000], проходит примерно половина
+    constexpr std::size_t column_block = 1024;
+    corpus<std::vector<double>> double_columns;
+    corpus<std::vector<int>> int_columns;
+    for (std::size_t b = 0; b < 64; ++b) {
+        std::vector<double> doubles(column_block);
+        std::vector<int> ints(column_block);
+        for (std::size_t i = 0; i < column_block; ++i) {
+            ints[i] = static_cast<int>(gen.pick(2001)) - 1000;
+            doubles[i] = ints[i] + 0.5;
+        }
+        double_columns.bytes += column_block * sizeof(double);
+        int_columns.bytes += column_block * sizeof(int);
+        double_columns.inputs.push_back(std::move(doubles));
+        int_columns.inputs.push_back(std::move(ints));
+    }
+
+    run("filter_range/double/input_check", double_columns, [](const std::vector<double> &v) {
+        std::size_t passed = 0;
+        for (double x: v) passed += input_check<double>(x, -500.0, 500.0).get_result().ok();
+        return passed != 0;
+    });
+    run("filter_range/double", double_columns, [](const std::vector<double> &v) {
+        return filter_range(v, -500.0, 500.0).count() != 0;
+    });
+    run("filter_range/int/input_check", int_columns, [](const std::vector<int> &v) {
+        std::size_t passed = 0;
+        for (int x: v) passed += input_check<int>(x, -500, 500).get_result().ok();
+        return passed != 0;
+    });
+    run("filter_range/int", int_columns, [](const std::vector<int> &v) {
+        return filter_range(v, -500, 500).count() != 0;
+    });
+    run("filter_range/int/indices", int_columns, [](const std::vector<int> &v) {
+        return !filter_range_indices(v, -500, 500).empty();
+    });
+
+    /* ---- Принятые значения пакета: отдельные строки или string_pool ---- */
+
+    // Вход - блок из 1024 строк decimal_data; принятые значения сохраняются
+    std::vector<std::string_view> decimal_views(decimal_data.inputs.begin(), decimal_data.inputs.end());
+    corpus<std::vector<std::string_view>> decimal_blocks;
+    for (std::size_t first = 0; first < decimal_views.size(); first += column_block) {
+        std::vector<std::string_view> block(decimal_views.begin() + static_cast<std::ptrdiff_t>(first),
+                                            decimal_views.begin() + static_cast<std::ptrdiff_t>(
+                                                    std::min(first + column_block, decimal_views.size())));
+        for (std::string_view s: block) decimal_blocks.bytes += s.size();
+        decimal_blocks.inputs.push_back(std::move(block));
+    }
+
+    std::vector<std::string> kept_strings;
+    run("batch/accepted/strings", decimal_blocks, [&kept_strings](const std::vector<std::string_view> &block) {
+        kept_strings.clear();
+        for (std::string_view s: block) {
+            input_check<std::string> checked(std::string(s), any_length, decimal);
+            if (checked.is_correct()) kept_strings.push_back(checked.get_value());
+        }
+        return !kept_strings.empty();
+    });
+    string_pool kept_pool;
+    run("batch/accepted/string_pool", decimal_blocks, [&kept_pool](const std::vector<std::string_view> &block) {
+        kept_pool.reset();
+        batch_options options;
+        options.accepted = &kept_pool;
+        check_batch(block, check_spec(any_length, decimal), options);
+        return !kept_pool.empty();
+    });
+
+    /* ---- Классификация: несколько шаблонов за один проход ---- */
+
+    // Смесь входов всех видов, как в маршрутизации; бит k - совпадение с routes[k]
+    // (number, email, url, phone_number, hex, date_YYYY_MM_DD из patterns)
+    const pattern_case *routes[] = {&patterns[1], &patterns[2], &patterns[3], &patterns[6], &patterns[7],
+                                    &patterns[4]};
+    const pattern_set route_set{rgxp::dfa::number, rgxp::dfa::email, rgxp::dfa::url, rgxp::dfa::phone_number,
+                                rgxp::dfa::hex, rgxp::dfa::date_YYYY_MM_DD};
+    corpus<std::string> mixed_data;
+    for (std::size_t i = 0; i < cfg.count; ++i) {
+        const corpus<std::string> &from = routes[i % std::size(routes)]->data;
+        mixed_data.inputs.push_back(from.inputs[i % from.inputs.size()]);
+        mixed_data.bytes += mixed_data.inputs.back().size();
+    }
+
+    run("classify/sequential_regex", mixed_data, [&routes](const std::string &s) {
+        pattern_set::mask_type mask = 0;
+        for (std::size_t k = 0; k < std::size(routes); ++k) {
+            mask |= static_cast<pattern_set::mask_type>(input_match(s, routes[k]->regex)) << k;
+        }
+        return mask != 0;
+    });
+    run("classify/sequential_dfa", mixed_data, [&routes](const std::string &s) {
+        pattern_set::mask_type mask = 0;
+        for (std::size_t k = 0; k < std::size(routes); ++k) {
+            mask |= static_cast<pattern_set::mask_type>(input_match(s, *routes[k]->automaton)) << k;
+        }
+        return mask != 0;
+    });
+    run("classify/pattern_set", mixed_data, [&route_set](const std::string &s) {
+        return route_set.match(s) != 0;
+    });
+
+    /* ---- Даты без регулярных выражений ---- */
+
+    auto datetime_data = gen.make([&] {
+        char buf[40];
+        std::snprintf(buf, sizeof(buf), "%04zu-%02zu-%02zuT%02zu:%02zu:%02zu.%03zuZ",
+                      1900 + gen.pick(200), 1 + gen.pick(12), 1 + gen.pick(28),
+                      gen.pick(24), gen.pick(60), gen.pick(60), gen.pick(1000));
+        return std::string(buf);
+    });
+
+    run("is_date/date_YYYY_MM_DD", date_data, [](const std::string &s) {
+        return is_date(s, date_format::iso_date);
+    });
+    run("is_date/date_any", date_any_data, [](const std::string &s) { return is_date(s); });
+    run("parse_date/iso_datetime", datetime_data, [](const std::string &s) {
+        date_result r = parse_date(s, date_format::iso_datetime);
+        return r && r.value.epoch_seconds() != 0;
+    });
+
+    // Столбец из count дат целиком; один вызов на проход по набору
+    std::vector<std::string_view> date_column(date_data.inputs.begin(), date_data.inputs.end());
+    std::vector<std::int64_t> epochs(date_column.size());
+    corpus<std::vector<std::string_view>> date_column_data;
+    date_column_data.inputs.push_back(date_column);
+    date_column_data.bytes = date_data.bytes;
+    run("parse_dates/column", date_column_data, [&epochs](const std::vector<std::string_view> &column) {
+        return parse_dates(column, date_format::iso_date, epochs.data()).count() != 0;
+    });
+
+    /* ---- record_schema ---- */
+
+    // Строка CSV из четырёх полей: число, имя, email, цвет
+    auto row_data = gen.make([&] {
+        std::string name = gen.narrow(eng_lower, std::max<std::size_t>(n / 4, 2));
+        name[0] = gen.pick(eng_upper);
+        return std::to_string(1 + gen.pick(120)) + "," + name + "," +
+               gen.narrow("abcdefghijklmnopqrstuvwxyz", std::max<std::size_t>(n / 4, 1)) + "@example.com," +
+               "#" + gen.narrow("0123456789abcdef", 6);
+    });
+    const record_schema schema({
+            field_rule().range(1, 120),
+            field_rule().lang(Eng),
+            field_rule().match(rgxp::dfa::email),
+            field_rule().match(rgxp::dfa::hex),
+    });
+    run("record_schema/validate_line", row_data, [&schema](const std::string &s) {
+        return schema.accepts_line(s);
+    });
+
+#ifdef INPCH_INSTRUMENTATION
+    std::fputs(stats::collect().to_text().c_str(), stderr);
+#endif
+
+    if (cfg.output.empty()) {
+        write_json(stdout, cfg, results);
+        return 0;
+    }
+    std::FILE *out = std::fopen(cfg.output.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "inputcheck_bench: cannot open %s\n", cfg.output.c_str());
+        return 2;
+    }
+    write_json(out, cfg, results);
+    std::fclose(out);
+    write_table(stdout, results);
+    return 0;
+}
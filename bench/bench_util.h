@@ -0,0 +1,20 @@
+#ifndef INPUTCHECK_BENCH_UTIL_H
+#define INPUTCHECK_BENCH_UTIL_H
+
+namespace inpch::bench {
+
+    // Не даёт компилятору выкинуть вычисление value: значение считается
+    // прочитанным, а память - изменённой
+    template<class T>
+    inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile T sink = value;
+        (void) sink;
+#endif
+    }
+
+} // inpch::bench
+
+#endif //INPUTCHECK_BENCH_UTIL_H
@@ -0,0 +1,34 @@
+#ifndef INPUTCHECK_CHECK_RESULT_H
+#define INPUTCHECK_CHECK_RESULT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace inpch {
+
+    enum class check_error : std::uint8_t {
+        none,
+        empty_input,
+        wrong_length,
+        wrong_character,
+        out_of_range,
+        no_match,
+        wrong_base,
+        wrong_language,
+        wrong_type
+    };
+
+    // Результат проверки без исключений. position - индекс первого неподходящего
+    // символа; если ошибка не связана с конкретным символом - размер строки
+    struct check_result {
+        std::size_t position;
+        check_error error;
+
+        constexpr bool ok() const noexcept { return error == check_error::none; }
+
+        constexpr explicit operator bool() const noexcept { return ok(); }
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_CHECK_RESULT_H
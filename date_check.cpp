@@ -0,0 +1,258 @@
+#include "date_check.h"
+
+namespace inpch {
+
+    std::int64_t date_time::days_since_epoch() const noexcept {
+        return days_from_civil(year, month, day);
+    }
+
+    std::int64_t date_time::epoch_seconds() const noexcept {
+        return days_since_epoch() * 86400 + hour * 3600 + minute * 60 + second - offset_minutes * 60;
+    }
+
+    namespace {
+
+        // Разбор слева направо; первая ошибка запоминается, дальнейшие вызовы
+        // ничего не делают и возвращают false
+        class date_parser {
+        public:
+            explicit date_parser(std::string_view input) noexcept : in(input) {}
+
+            date_result result() const noexcept {
+                if (error != check_error::none) return {date_time{}, error, error_at};
+                return {value, check_error::none, in.size()};
+            }
+
+            bool ok() const noexcept { return error == check_error::none; }
+
+            bool at_end() const noexcept { return at == in.size(); }
+
+            std::size_t offset() const noexcept { return at; }
+
+            char peek() const noexcept { return at < in.size() ? in[at] : '\0'; }
+
+            bool fail(std::size_t position, check_error why) noexcept {
+                if (error == check_error::none) {
+                    error = why;
+                    error_at = position;
+                }
+                return false;
+            }
+
+            // Ровно count цифр
+            bool digits(std::size_t count, unsigned &out) noexcept {
+                if (!ok()) return false;
+                unsigned acc = 0;
+                for (std::size_t k = 0; k < count; ++k, ++at) {
+                    if (at == in.size()) return fail(at, check_error::wrong_length);
+                    unsigned d = static_cast<unsigned char>(in[at]) - unsigned('0');
+                    if (d > 9) return fail(at, check_error::wrong_character);
+                    acc = acc * 10 + d;
+                }
+                out = acc;
+                return true;
+            }
+
+            // Одна или две цифры
+            bool short_number(unsigned &out) noexcept {
+                if (!digits(1, out)) return false;
+                unsigned d = static_cast<unsigned char>(peek()) - unsigned('0');
+                if (d <= 9) {
+                    out = out * 10 + d;
+                    ++at;
+                }
+                return true;
+            }
+
+            bool expect(char ch) noexcept {
+                if (!ok()) return false;
+                if (at == in.size()) return fail(at, check_error::wrong_length);
+                if (in[at] != ch) return fail(at, check_error::wrong_character);
+                ++at;
+                return true;
+            }
+
+            bool in_range(unsigned number, unsigned low, unsigned high, std::size_t field) noexcept {
+                if (!ok()) return false;
+                if (number < low || number > high) return fail(field, check_error::out_of_range);
+                return true;
+            }
+
+            bool finish() noexcept {
+                if (!ok()) return false;
+                if (at != in.size()) return fail(at, check_error::wrong_character);
+                return true;
+            }
+
+            void skip() noexcept { ++at; }
+
+            date_time value{};
+
+        private:
+            std::string_view in;
+            std::size_t at = 0;
+            check_error error = check_error::none;
+            std::size_t error_at = 0;
+        };
+
+        bool check_day(date_parser &p, unsigned day, std::size_t field) noexcept {
+            return p.in_range(day, 1, days_in_month(p.value.year, p.value.month), field);
+        }
+
+        // hh:mm[:ss[.f]][Z|±hh:mm|±hhmm] после разделителя даты и времени
+        bool parse_time(date_parser &p) noexcept {
+            unsigned hour = 0, minute = 0, second = 0;
+            std::size_t field = p.offset();
+            if (!p.digits(2, hour) || !p.in_range(hour, 0, 23, field)) return false;
+            field = p.offset() + 1;
+            if (!p.expect(':') || !p.digits(2, minute) || !p.in_range(minute, 0, 59, field)) return false;
+            if (p.peek() == ':') {
+                p.skip();
+                field = p.offset();
+                if (!p.digits(2, second) || !p.in_range(second, 0, 59, field)) return false;
+                if (p.peek() == '.' || p.peek() == ',') {
+                    p.skip();
+                    unsigned d;
+                    if (!p.digits(1, d)) return false;
+                    std::uint32_t fraction = d, scale = 100000000;
+                    for (std::size_t k = 1; static_cast<unsigned char>(p.peek()) - unsigned('0') <= 9; ++k) {
+                        if (k < 9) {
+                            fraction = fraction * 10 + (static_cast<unsigned char>(p.peek()) - '0');
+                            scale /= 10;
+                        }
+                        p.skip();
+                    }
+                    p.value.nanosecond = fraction * scale;
+                }
+            }
+            p.value.has_time = true;
+            p.value.hour = static_cast<std::uint8_t>(hour);
+            p.value.minute = static_cast<std::uint8_t>(minute);
+            p.value.second = static_cast<std::uint8_t>(second);
+
+            char zone = p.peek();
+            if (zone == 'Z' || zone == 'z') {
+                p.skip();
+                p.value.has_offset = true;
+            } else if (zone == '+' || zone == '-') {
+                p.skip();
+                unsigned offset_hours = 0, offset_minutes = 0;
+                field = p.offset();
+                // Смещения часовых поясов - от -12:00 до +14:00, больше ±14:00 не бывает
+                if (!p.digits(2, offset_hours) || !p.in_range(offset_hours, 0, 14, field)) return false;
+                if (p.peek() == ':') p.skip();
+                field = p.offset();
+                const unsigned max_minutes = offset_hours == 14 ? 0 : 59;
+                if (!p.digits(2, offset_minutes) || !p.in_range(offset_minutes, 0, max_minutes, field)) return false;
+                int total = static_cast<int>(offset_hours * 60 + offset_minutes);
+                p.value.offset_minutes = static_cast<std::int16_t>(zone == '-' ? -total : total);
+                p.value.has_offset = true;
+            }
+            return p.finish();
+        }
+
+        bool parse_iso(date_parser &p, date_format format) noexcept {
+            unsigned year = 0, month = 0, day = 0;
+            if (!p.digits(4, year) || !p.expect('-')) return false;
+            if (!p.digits(2, month) || !p.in_range(month, 1, 12, 5) || !p.expect('-')) return false;
+            if (!p.digits(2, day)) return false;
+            p.value.year = static_cast<std::int32_t>(year);
+            p.value.month = static_cast<std::uint8_t>(month);
+            if (!check_day(p, day, 8)) return false;
+            p.value.day = static_cast<std::uint8_t>(day);
+
+            if (format == date_format::iso_date || (format != date_format::iso_datetime && p.at_end())) {
+                return p.finish();
+            }
+            if (p.at_end()) return p.fail(p.offset(), check_error::wrong_length);
+            char separator = p.peek();
+            if (separator != 'T' && separator != 't' && separator != ' ') {
+                return p.fail(p.offset(), check_error::wrong_character);
+            }
+            p.skip();
+            return parse_time(p);
+        }
+
+        bool parse_dmy(date_parser &p, date_format format) noexcept {
+            unsigned day = 0, month = 0, year = 0;
+            if (!p.short_number(day)) return false;
+
+            // Второй разделитель должен совпадать с первым
+            char separator = p.peek();
+            bool allowed;
+            switch (format) {
+                case date_format::dmy_dot:
+                    allowed = separator == '.';
+                    break;
+                case date_format::dmy_slash:
+                    allowed = separator == '/';
+                    break;
+                case date_format::dmy_dash:
+                    allowed = separator == '-';
+                    break;
+                default:
+                    allowed = separator == '.' || separator == '/' || separator == '-';
+                    break;
+            }
+            if (!allowed) {
+                return p.fail(p.offset(), p.at_end() ? check_error::wrong_length : check_error::wrong_character);
+            }
+            p.skip();
+
+            std::size_t month_field = p.offset();
+            if (!p.short_number(month) || !p.in_range(month, 1, 12, month_field)) return false;
+            if (!p.expect(separator) || !p.digits(2, year)) return false;
+            if (p.at_end()) {
+                // Год из двух цифр - по правилу POSIX strptime %y: 69-99 - 1900-е, 00-68 - 2000-е
+                year += year >= 69 ? 1900 : 2000;
+            } else {
+                unsigned low = 0;
+                if (!p.digits(2, low)) return false;
+                year = year * 100 + low;
+            }
+            p.value.year = static_cast<std::int32_t>(year);
+            p.value.month = static_cast<std::uint8_t>(month);
+            if (!check_day(p, day, 0)) return false;
+            p.value.day = static_cast<std::uint8_t>(day);
+            return p.finish();
+        }
+
+        bool starts_with_year(std::string_view input) noexcept {
+            if (input.size() < 4) return false;
+            for (std::size_t i = 0; i < 4; ++i) {
+                if (static_cast<unsigned char>(input[i]) - unsigned('0') > 9) return false;
+            }
+            return true;
+        }
+
+    } // namespace
+
+    date_result parse_date(std::string_view input, date_format format) noexcept {
+        if (input.empty()) return {date_time{}, check_error::empty_input, 0};
+        date_parser p(input);
+        switch (format) {
+            case date_format::any:
+                if (starts_with_year(input)) {
+                    parse_iso(p, date_format::iso);
+                } else {
+                    parse_dmy(p, date_format::dmy);
+                }
+                break;
+            case date_format::iso:
+            case date_format::iso_date:
+            case date_format::iso_datetime:
+                parse_iso(p, format);
+                break;
+            case date_format::dmy:
+            case date_format::dmy_dot:
+            case date_format::dmy_slash:
+            case date_format::dmy_dash:
+                parse_dmy(p, format);
+                break;
+            default:
+                return {date_time{}, check_error::wrong_type, 0};
+        }
+        return p.result();
+    }
+
+} // inpch
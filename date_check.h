@@ -0,0 +1,92 @@
+#ifndef INPUTCHECK_DATE_CHECK_H
+#define INPUTCHECK_DATE_CHECK_H
+
+#include "check_result.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace inpch {
+
+    enum class date_format : std::uint8_t {
+        any,          // любой из форматов ниже; ISO узнаётся по четырём цифрам в начале
+        iso,          // iso_date или iso_datetime
+        iso_date,     // YYYY-MM-DD
+        iso_datetime, // YYYY-MM-DDThh:mm[:ss[.f]][Z|±hh:mm|±hhmm], вместо T допустимы t и пробел
+        dmy,          // dmy_dot, dmy_slash или dmy_dash
+        dmy_dot,      // DD.MM.YYYY или DD.MM.YY
+        dmy_slash,    // DD/MM/YYYY или DD/MM/YY
+        dmy_dash      // DD-MM-YYYY или DD-MM-YY
+    };
+
+    // День и месяц в форматах dmy могут состоять из одной цифры (1.5.2023), как в
+    // rgxp::date_any. Год в dmy - из четырёх цифр или из двух: 69-99 - это 1969-1999,
+    // 00-68 - 2000-2068, как %y у strptime. Отличия от rgxp::date_any: 29.02.00 верна
+    // (2000 год високосный), годы до 1600 не отклоняются. Дробная часть секунд - от
+    // 1 цифры, учитываются первые девять. Секунда 60 не допускается. Смещение - не
+    // больше ±14:00, иначе out_of_range.
+    struct date_time {
+        std::int32_t year;
+        std::uint8_t month;
+        std::uint8_t day;
+        std::uint8_t hour;
+        std::uint8_t minute;
+        std::uint8_t second;
+        std::uint32_t nanosecond;
+        std::int16_t offset_minutes; // смещение от UTC, 0 если не указано
+        bool has_time;
+        bool has_offset;
+
+        // Дней от 1970-01-01 по пролептическому григорианскому календарю
+        std::int64_t days_since_epoch() const noexcept;
+
+        // Секунд от 1970-01-01T00:00:00Z; время без смещения считается UTC
+        std::int64_t epoch_seconds() const noexcept;
+    };
+
+    struct date_result {
+        date_time value;
+        check_error error;
+        // Индекс первого неподходящего символа; при out_of_range - начало поля
+        // (месяца, дня, часа...), при wrong_length - размер строки
+        std::size_t position;
+
+        explicit operator bool() const noexcept { return error == check_error::none; }
+    };
+
+    // Проверка по календарю (високосные годы, длина месяцев) и разбор за один
+    // проход, без регулярных выражений и выделения памяти
+    date_result parse_date(std::string_view input, date_format format = date_format::any) noexcept;
+
+    inline check_result check_date(std::string_view input, date_format format = date_format::any) noexcept {
+        date_result result = parse_date(input, format);
+        return {result.position, result.error};
+    }
+
+    inline bool is_date(std::string_view input, date_format format = date_format::any) noexcept {
+        return parse_date(input, format).error == check_error::none;
+    }
+
+    constexpr bool is_leap_year(std::int32_t year) noexcept {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    constexpr unsigned days_in_month(std::int32_t year, unsigned month) noexcept {
+        constexpr unsigned char days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return month == 2 && is_leap_year(year) ? 29u : days[month - 1];
+    }
+
+    // Номер дня от 1970-01-01 (алгоритм days_from_civil Говарда Хиннанта)
+    constexpr std::int64_t days_from_civil(std::int32_t year, unsigned month, unsigned day) noexcept {
+        const std::int64_t y = static_cast<std::int64_t>(year) - (month <= 2);
+        const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const std::int64_t year_of_era = y - era * 400;
+        const std::int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const std::int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146097 + day_of_era - 719468;
+    }
+
+} // inpch
+
+#endif //INPUTCHECK_DATE_CHECK_H
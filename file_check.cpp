@@ -0,0 +1,178 @@
+#include "file_check.h"
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inpch {
+
+#if defined(_WIN32)
+
+    mapped_file::mapped_file(const std::string &path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), path);
+        }
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(file, &length)) {
+            auto error = static_cast<int>(GetLastError());
+            CloseHandle(file);
+            throw std::system_error(error, std::system_category(), path);
+        }
+        if (length.QuadPart == 0) {
+            CloseHandle(file);
+            return;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        auto error = static_cast<int>(GetLastError());
+        CloseHandle(file);
+        if (!mapping) throw std::system_error(error, std::system_category(), path);
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        error = static_cast<int>(GetLastError());
+        CloseHandle(mapping);
+        if (!view) throw std::system_error(error, std::system_category(), path);
+        data = static_cast<const char *>(view);
+        size = static_cast<std::size_t>(length.QuadPart);
+    }
+
+    void mapped_file::unmap() noexcept {
+        if (data) UnmapViewOfFile(data);
+    }
+
+#else
+
+    mapped_file::mapped_file(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), path);
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        if (info.st_size == 0) {
+            ::close(fd);
+            return;
+        }
+        void *view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        int error = errno;
+        ::close(fd);
+        if (view == MAP_FAILED) throw std::system_error(error, std::generic_category(), path);
+        ::madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+        data = static_cast<const char *>(view);
+        size = static_cast<std::size_t>(info.st_size);
+    }
+
+    void mapped_file::unmap() noexcept {
+        if (data) ::munmap(const_cast<char *>(data), size);
+    }
+
+#endif
+
+    mapped_file::~mapped_file() {
+        unmap();
+    }
+
+    mapped_file::mapped_file(mapped_file &&other) noexcept: data(other.data), size(other.size) {
+        other.data = nullptr;
+        other.size = 0;
+    }
+
+    mapped_file &mapped_file::operator=(mapped_file &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            data = other.data;
+            size = other.size;
+            other.data = nullptr;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    namespace {
+
+        // Номера строк в rejects локальны для куска и исправляются при слиянии
+        struct chunk_report {
+            std::uint64_t lines = 0;
+            std::uint64_t rejected = 0;
+            std::vector<rejected_line> rejects;
+        };
+
+        void check_chunk(std::string_view text, std::size_t first, std::size_t last, const check_spec &spec,
+                         const file_check_options &options, chunk_report &report) {
+            std::size_t pos = first;
+            while (pos < last) {
+                const void *found = std::memchr(text.data() + pos, '\n', last - pos);
+                std::size_t end = found ? static_cast<const char *>(found) - text.data() : last;
+                std::size_t line_end = end;
+                if (options.strip_cr && line_end > pos && text[line_end - 1] == '\r') --line_end;
+
+                ++report.lines;
+                if (!spec(text.substr(pos, line_end - pos))) {
+                    ++report.rejected;
+                    if (report.rejects.size() < options.max_rejects) {
+                        report.rejects.push_back({report.lines, pos});
+                    }
+                }
+                pos = end + 1;
+            }
+        }
+
+    } // namespace
+
+    file_report check_lines(std::string_view text, const check_spec &spec, const file_check_options &options) {
+        // Границы кусков сдвигаются на ближайший '\n', чтобы строка целиком попадала в один кусок
+        std::vector<std::size_t> bounds{0};
+        std::size_t chunk = std::max<std::size_t>(options.chunk_bytes, 1);
+        while (bounds.back() < text.size()) {
+            std::size_t next = bounds.back() + chunk;
+            if (next >= text.size()) {
+                next = text.size();
+            } else {
+                const void *found = std::memchr(text.data() + next, '\n', text.size() - next);
+                next = found ? static_cast<const char *>(found) - text.data() + 1 : text.size();
+            }
+            bounds.push_back(next);
+        }
+
+        std::vector<chunk_report> chunks(bounds.size() - 1);
+        auto run = [&](std::size_t c) {
+            check_chunk(text, bounds[c], bounds[c + 1], spec, options, chunks[c]);
+        };
+        thread_pool &pool = options.pool ? *options.pool : default_thread_pool();
+        if (chunks.size() > 1) {
+            pool.parallel_for(chunks.size(), run);
+        } else if (!chunks.empty()) {
+            run(0);
+        }
+
+        file_report report;
+        for (auto &c: chunks) {
+            for (auto &reject: c.rejects) {
+                if (report.rejects.size() >= options.max_rejects) break;
+                report.rejects.push_back({report.lines + reject.line, reject.offset});
+            }
+            report.lines += c.lines;
+            report.rejected += c.rejected;
+        }
+        report.accepted = report.lines - report.rejected;
+        return report;
+    }
+
+    file_report check_file(const std::string &path, const check_spec &spec, const file_check_options &options) {
+        mapped_file file(path);
+        return check_lines(file.contents(), spec, options);
+    }
+
+} // inpch
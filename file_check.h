@@ -0,0 +1,70 @@
+#ifndef INPUTCHECK_FILE_CHECK_H
+#define INPUTCHECK_FILE_CHECK_H
+
+#include "batch_check.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inpch {
+
+    // Файл, отображённый в память только для чтения
+    class mapped_file {
+    public:
+        // Бросает std::system_error, если файл не открывается или не отображается
+        explicit mapped_file(const std::string &path);
+
+        ~mapped_file();
+
+        mapped_file(mapped_file &&other) noexcept;
+
+        mapped_file &operator=(mapped_file &&other) noexcept;
+
+        mapped_file(const mapped_file &) = delete;
+
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        std::string_view contents() const noexcept { return {data, size}; }
+
+    private:
+        const char *data = nullptr;
+        std::size_t size = 0;
+
+        void unmap() noexcept;
+    };
+
+    struct rejected_line {
+        std::uint64_t line;   // номер строки, начиная с 1
+        std::uint64_t offset; // смещение начала строки в байтах
+    };
+
+    struct file_report {
+        std::uint64_t lines = 0;
+        std::uint64_t accepted = 0;
+        std::uint64_t rejected = 0;
+        // Отклонённые строки в порядке следования, не больше max_rejects
+        std::vector<rejected_line> rejects;
+    };
+
+    struct file_check_options {
+        // Сколько отклонённых строк сохранять в отчёте; счётчики считаются всегда полностью
+        std::size_t max_rejects = std::numeric_limits<std::size_t>::max();
+        // Примерный размер куска, который проверяется одной задачей пула
+        std::size_t chunk_bytes = 4u << 20;
+        // Отбрасывать '\r' перед '\n' (файлы с окончаниями CRLF)
+        bool strip_cr = true;
+        // nullptr - default_thread_pool()
+        thread_pool *pool = nullptr;
+    };
+
+    // Проверяет каждую строку текста, разделённого '\n', без копирования строк
+    file_report check_lines(std::string_view text, const check_spec &spec, const file_check_options &options = {});
+
+    file_report check_file(const std::string &path, const check_spec &spec, const file_check_options &options = {});
+
+} // inpch
+
+#endif //INPUTCHECK_FILE_CHECK_H
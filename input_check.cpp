@@ -1,51 +1,163 @@
 #include "input_check.h"
 
+#include <cstdlib>
+#include <limits>
+
 namespace inpch {
 
+    namespace {
+
+        // Строка в UTF-8: кириллическая буква - пара байтов, остальные не-ASCII символы
+        // ни цифрами, ни буквами не считаются
+        content_type classify(const std::string &content_string) noexcept {
+            bool digit = false, text  = false;
+            const std::size_t size = content_string.size();
+            for (std::size_t i = 0; i < size && !(digit && text); ++i) {
+                auto ch = static_cast<unsigned char>(content_string[i]);
+                if (ch < 0x80) {
+                    digit |= std::isdigit(ch) != 0;
+                    text  |= std::isalpha(ch) != 0;
+                } else if (i + 1 < size &&
+                           simd::first_not_cyrillic(content_string.data() + i, 2, simd::cyrillic_class::alpha) == 2) {
+                    text = true;
+                    ++i;
+                }
+            }
+            if (digit && text) return content_type::text_with_numbers;
+            if (digit) return content_type::number;
+            return content_type::text;
+        }
+
+        // Широкая строка: цифры и буквы ищутся по кодовым единицам целиком; std::isdigit
+        // и std::isalpha для значений wchar_t вне unsigned char не определены
+        content_type classify(const std::wstring &content_string) noexcept {
+            const wchar_t *data = content_string.data();
+            const std::size_t size = content_string.size();
+            bool digit = simd::first_of(data, size, simd::byte_class::decimal) != size;
+            bool text  = simd::first_of(data, size, simd::byte_class::alpha) != size ||
+                         simd::first_cyrillic(data, size, simd::cyrillic_class::alpha) != size;
+            if (digit && text) return content_type::text_with_numbers;
+            if (digit) return content_type::number;
+            return content_type::text;
+        }
+
+    } // namespace
+
     content_type content_type_of(const std::string &content_string) {
+#ifdef INPCH_EXCEPTIONS
         if (content_string.empty()) throw std::length_error("content_string");
-        bool digit = false, text  = false;
-        for (const char  &ch : content_string) {
-            digit |= std::isdigit(ch);
-            text  |= std::isalpha(ch);
-        }
-        if (digit && text) return content_type::text_with_numbers;
-        if (digit) return content_type::number;
-        return content_type::text;
+#endif
+        return stats::measure(stats::check_id::content_type_of, stats::bytes_of(content_string), check_error::none,
+                              [&]() noexcept { return classify(content_string); });
     }
 
     content_type content_type_of(const std::wstring  &content_string) {
+#ifdef INPCH_EXCEPTIONS
         if (content_string.empty()) throw std::length_error("content_string");
-        bool digit = false, text  = false;
-        for (const wchar_t  &ch : content_string) {
-            digit |= std::isdigit(ch);
-            #if defined(__MINGW64__) || defined(__MINGW32__)
-            text  |= std::isalpha(ch) ||
-                    (rus_alphabet.find(ch) != rus_alphabet.end()) ||
-                    (RUS_alphabet.find(ch) != RUS_alphabet.end());
-            #else
-            text  |= std::isalpha(ch);
-            #endif
-        }
-        if (digit && text) return content_type::text_with_numbers;
-        if (digit) return content_type::number;
-        return content_type::text;
+#endif
+        return stats::measure(stats::check_id::content_type_of, stats::bytes_of(content_string), check_error::none,
+                              [&]() noexcept { return classify(content_string); });
     }
 
     bool input_match(const std::string &input_string, const std::string &regex_string) {
-        return std::regex_match(input_string, std::regex(regex_string));
+        return stats::measure(stats::check_id::input_match_regex, input_string.size(), check_error::no_match, [&] {
+            return std::regex_match(input_string, *default_regex_cache().get(regex_string));
+        });
+    }
+
+    bool input_match(const std::string &input_string, const std::string &regex_string,
+                     std::regex_constants::syntax_option_type flags) {
+        return stats::measure(stats::check_id::input_match_regex, input_string.size(), check_error::no_match, [&] {
+            return std::regex_match(input_string, *default_regex_cache().get(regex_string, flags));
+        });
     }
 
     bool input_match(const std::string &input_string, const std::regex &regex) {
-        return std::regex_match(input_string, regex);
+        return stats::measure(stats::check_id::input_match_regex, input_string.size(), check_error::no_match, [&] {
+            return std::regex_match(input_string, regex);
+        });
+    }
+
+    bool input_match(const std::string &input_string, const std::string &regex_string, result_cache &cache) {
+        return stats::measure(stats::check_id::input_match_regex, input_string.size(), check_error::no_match, [&] {
+            return cache.get_or_check(result_cache::spec_of_text(regex_string), input_string, [&]() -> check_result {
+                bool ok = std::regex_match(input_string, *default_regex_cache().get(regex_string));
+                return {input_string.size(), ok ? check_error::none : check_error::no_match};
+            }).ok();
+        });
+    }
+
+    bool input_match(const std::string &input_string, const std::regex &regex, result_cache &cache) {
+        return stats::measure(stats::check_id::input_match_regex, input_string.size(), check_error::no_match, [&] {
+            return cache.get_or_check(result_cache::spec_of(&regex), input_string, [&]() -> check_result {
+                bool ok = std::regex_match(input_string, regex);
+                return {input_string.size(), ok ? check_error::none : check_error::no_match};
+            }).ok();
+        });
+    }
+
+    bool input_match(std::string_view input_string, const dfa &pattern) noexcept {
+        return stats::measure(stats::check_id::input_match_dfa, input_string.size(), check_error::no_match,
+                              [&]() noexcept { return pattern.match(input_string); });
+    }
+
+    bool input_match(std::string_view input_string, const dfa_pattern &pattern) {
+        return input_match(input_string, pattern.get());
+    }
+
+    check_result check_match(std::string_view input, const dfa &pattern) noexcept {
+        dfa::state_type state = pattern.start_state();
+        std::size_t stop = pattern.advance_until_dead(state, input);
+        if (state == dfa::dead_state) return {stop, check_error::no_match};
+        if (!pattern.is_accepting(state)) return {input.size(), check_error::no_match};
+        return {input.size(), check_error::none};
+    }
+
+    check_result check_match(const std::string &input, const std::regex &regex) noexcept {
+#ifdef INPCH_EXCEPTIONS
+        try {
+            if (std::regex_match(input, regex)) return {input.size(), check_error::none};
+        } catch (const std::regex_error &) {
+        }
+#else
+        if (std::regex_match(input, regex)) return {input.size(), check_error::none};
+#endif
+        return {input.size(), check_error::no_match};
+    }
+
+    check_result check_match(const std::string &input, const std::regex &regex, result_cache &cache) noexcept {
+        return cache.get_or_check(result_cache::spec_of(&regex), input, [&]() noexcept {
+            return check_match(input, regex);
+        });
     }
 
+    // Конец ввода и ошибка потока бросают InputClosedException: повторное чтение
+    // из такого потока сразу снова завершается неудачей, и цикл крутился бы вечно.
+    // Нечисловой ввод пропускается до конца строки, иначе он читался бы снова
+
+    namespace {
+
+        // Без исключений вернуть из *_input_loop нечего, поэтому конец ввода
+        // завершает программу; input_loop.h сообщает о нём статусом
+        [[noreturn]] void input_closed() {
+#ifdef INPCH_EXCEPTIONS
+            throw InputClosedException();
+#else
+            std::abort();
+#endif
+        }
+
+    } // namespace
+
     int int_input_loop(const int &l, const int &r, const std::string &err, bool in_range) {
         int input;
         while (true) {
             std::cin >> input;
             if (std::cin.fail()) {
+                if (std::cin.eof() || std::cin.bad()) input_closed();
                 std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cerr << err << std::endl;
                 continue;
             }
             if (!input_check<int>(input, l, r, in_range).is_correct()) {
@@ -61,7 +173,10 @@ namespace inpch {
         while (true) {
             std::wcin >> input;
             if (std::wcin.fail()) {
+                if (std::wcin.eof() || std::wcin.bad()) input_closed();
                 std::wcin.clear();
+                std::wcin.ignore(std::numeric_limits<std::streamsize>::max(), L'\n');
+                std::wcerr << err << std::endl;
                 continue;
             }
             if (!input_check<int>(input, l, r, in_range).is_correct()) {
@@ -75,11 +190,7 @@ namespace inpch {
     std::string str_num_input_loop(const base_type &base, const std::string &err, const int &length) {
         std::string input;
         while (true) {
-            std::getline(std::cin, input);
-            if (std::cin.fail()) {
-                std::cin.clear();
-                continue;
-            }
+            if (!std::getline(std::cin, input)) input_closed();
             if (!input_check<std::string>(input, length, base).is_correct()) {
                 std::cerr << err << std::endl;
                 continue;
@@ -91,11 +202,7 @@ namespace inpch {
     std::wstring wstr_num_input_loop(const base_type &base, const std::wstring &err, const int &length) {
         std::wstring input;
         while (true) {
-            std::getline(std::wcin, input);
-            if (std::cin.fail()) {
-                std::cin.clear();
-                continue;
-            }
+            if (!std::getline(std::wcin, input)) input_closed();
             if (!input_check<std::wstring>(input, length, base).is_correct()) {
                 std::wcerr << err << std::endl;
                 continue;
@@ -1,78 +1,139 @@
 #ifndef INPUTCHECK_INPUT_CHECK_H
 #define INPUTCHECK_INPUT_CHECK_H
 
-#if defined(__MINGW32__) || defined(__MINGW64__)
-
-#define CYRILLIC_CHAR_TYPE wchar_t
-#define PFX(l) (L'l')
-
-#elif defined(_MSC_VER)
-
-#define CYRILLIC_CHAR_TYPE char
-#define PFX(l) (l)
-
-#endif
-
 #if defined(__cplusplus) && __cplusplus >= 201703L
 
 #define REGEX const std::regex
-#define ALPHA_SET(_type) const std::set<_type>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define INPCH_EXCEPTIONS 1
+#endif
 
 #include <iostream>
-#include <set>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
 #include <algorithm>
 #include <exception>
 #include <regex>
 
+#include "check_result.h"
+#include "instrumentation.h"
+#include "input_simd.h"
+#include "input_dfa.h"
+#include "regex_cache.h"
+#include "result_cache.h"
+
 namespace rgxp {
-    inline REGEX contain_digit("\\d+");
+    // Тексты шаблонов, общие для std::regex и для rgxp::dfa
+    namespace source {
+        inline constexpr const char *number = R"(\d{1,})";
+
+        inline constexpr const char *email = "[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}";
+
+        inline constexpr const char *url = R"(https?://(?:www\.)?[-a-zA-Z0-9@:%._\+~#=]{2,256}\.[a-zA-Z0-9]{2,6})";
+
+        inline constexpr const char *phone_number =
+                R"(\+?\d{1,3}?[-.\s]?\(?\d{1,3}?\)?[-.\s]?\d{1,4}[-.\s]?\d{1,4}[-.\s]?\d{1,9})";
+
+        inline constexpr const char *hex = R"(#?([a-f0-9]{6}|[a-f0-9]{3}))";
+
+        inline constexpr const char *date_YYYY_MM_DD = R"(\d{4}-(?:0[1-9]|1[0-2])-(?:0[1-9]|[12]\d|3[01]))";
+    }
+
+    // Шаблоны std::regex компилируются при первом обращении (см. inpch::regex_pattern)
+    inline const inpch::regex_pattern contain_digit("\\d+");
+
+    inline const inpch::regex_pattern number(source::number);
+
+    inline const inpch::regex_pattern email(source::email);
+
+    inline const inpch::regex_pattern url(source::url);
+
+    // Только форма даты: число дней в месяце не проверяется, для этого есть inpch::is_date
+    inline const inpch::regex_pattern date_YYYY_MM_DD(source::date_YYYY_MM_DD);
+
+    // D.M.YY - DD.MM.YYYY с одним из разделителей . / -, годы 1600-9999 или две цифры.
+    // Проверяет и число дней в месяце, и 29 февраля високосного года; разбор в поля и
+    // та же проверка быстрее - inpch::parse_date с date_format::dmy
+    inline const inpch::regex_pattern date_any(
+            R"(^(?:(?:31(\/|-|\.)(?:0?[13578]|1[02]))\1|(?:(?:29|30)(\/|-|\.)(?:0?[13-9]|1[0-2])\2))(?:(?:1[6-9]|[2-9]\d)?\d{2})$|)"
+            R"(^(?:29(\/|-|\.)0?2\3(?:(?:(?:1[6-9]|[2-9]\d)?(?:0[48]|[2468][048]|[13579][26])|(?:(?:16|[2468][048]|[3579][26])00))))$|)"
+            R"(^(?:0?[1-9]|1\d|2[0-8])(\/|-|\.)(?:(?:0?[1-9])|(?:1[0-2]))\4(?:(?:1[6-9]|[2-9]\d)?\d{2})$)");
+
+    inline const inpch::regex_pattern phone_number(source::phone_number);
 
-    inline REGEX number(R"(/^\d{1,}$/)");
+    inline const inpch::regex_pattern hex(source::hex);
 
-    inline REGEX email("[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}");
+    // Те же шаблоны в виде ДКА, собираемых при первом использовании
+    namespace dfa {
+        inline const inpch::dfa_pattern number(source::number);
 
-    inline REGEX url(R"(https?://(?:www\.)?[-a-zA-Z0-9@:%._\+~#=]{2,256}\.[a-zA-Z0-9]{2,6})");
+        inline const inpch::dfa_pattern email(source::email);
 
-    inline REGEX date_YYYY_MM_DD(R"(\d{4}-\d{2}-\d{2})");
+        inline const inpch::dfa_pattern url(source::url);
 
-    inline REGEX date_any(R"(/^(?:(?:31(\/|-|\.)(?:0?[13578]|1[02]))\1|(?:(?:29|30)(\/|-|\.)
-(?:0?[1,3-9]|1[0-2])\2))(?:(?:1[6-9]|[2-9]\d)?\d{2})$|^(?:29(\/|-|\.)0?2\3(?:(?:(?:1[6-9]|[2-9]\d)?
-(?:0[48]|[2468][048]|[13579][26])|(?:(?:16|[2468][048]|[3579][26])00))))$|^(?:0?[1-9]|1\d|2[0-8])(\/|-|\.)
-(?:(?:0?[1-9])|(?:1[0-2]))\4(?:(?:1[6-9]|[2-9]\d)?\d{2})$/)");
+        inline const inpch::dfa_pattern phone_number(source::phone_number);
 
-    inline REGEX phone_number(R"(\+?\d{1,3}?[-.\s]?\(?\d{1,3}?\)?[-.\s]?\d{1,4}[-.\s]?\d{1,4}[-.\s]?\d{1,9})");
+        inline const inpch::dfa_pattern hex(source::hex);
 
-    inline REGEX hex(R"(/^#?([a-f0-9]{6}|[a-f0-9]{3})$/)");
+        inline const inpch::dfa_pattern date_YYYY_MM_DD(source::date_YYYY_MM_DD);
+    }
 }
 
 namespace inpch {
 
     inline const int any_length = -1;
 
-    inline ALPHA_SET(char) eng_alphabet{
-            'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
-            'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'
-    };
+    // Алфавит строится на этапе компиляции: кодовые точки до 255 хранятся
+    // 256-битной таблицей, остальные - диапазонами (кириллица)
+    class alphabet {
+    public:
+        constexpr alphabet(char32_t first, char32_t last) noexcept {
+            add(first, last);
+        }
 
-    inline ALPHA_SET(CYRILLIC_CHAR_TYPE) rus_alphabet{
-            PFX(а), PFX(б), PFX(в), PFX(г), PFX(д), PFX(е), PFX(ё), PFX(ж),
-            PFX(з), PFX(и), PFX(й), PFX(к), PFX(л), PFX(м), PFX(н), PFX(о),
-            PFX(п), PFX(р), PFX(с), PFX(т), PFX(у), PFX(ф), PFX(х), PFX(ц),
-            PFX(ч), PFX(ш), PFX(щ), PFX(ъ), PFX(ы), PFX(ь), PFX(э), PFX(ю), PFX(я)
-    };
+        constexpr alphabet(char32_t first, char32_t last, char32_t extra) noexcept {
+            add(first, last);
+            add(extra, extra);
+        }
 
-    inline ALPHA_SET(char) ENG_alphabet{
-            'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
-            'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z'
-    };
+        constexpr bool contains(char32_t ch) const noexcept {
+            if (ch < 256) {
+                return (table[ch >> 6] >> (ch & 63)) & 1u;
+            }
+            for (int k = 0; k < ranges; ++k) {
+                if (ch >= range_first[k] && ch <= range_last[k]) return true;
+            }
+            return false;
+        }
 
-    inline ALPHA_SET(CYRILLIC_CHAR_TYPE) RUS_alphabet{
-            PFX(А), PFX(Б), PFX(В), PFX(Г), PFX(Д), PFX(Е), PFX(Ё), PFX(Ж),
-            PFX(З), PFX(И), PFX(Й), PFX(К), PFX(Л), PFX(М), PFX(Н), PFX(О),
-            PFX(П), PFX(Р), PFX(С), PFX(Т), PFX(У), PFX(Ф), PFX(Х), PFX(Ц),
-            PFX(Ч), PFX(Ш), PFX(Щ), PFX(Ъ), PFX(Ы), PFX(Ь), PFX(Э), PFX(Ю), PFX(Я)
+    private:
+        std::uint64_t table[4]{};
+        char32_t range_first[2]{};
+        char32_t range_last[2]{};
+        int ranges = 0;
+
+        constexpr void add(char32_t first, char32_t last) noexcept {
+            for (char32_t ch = first; ch <= last && ch < 256; ++ch) {
+                table[ch >> 6] |= std::uint64_t{1} << (ch & 63);
+            }
+            if (last >= 256) {
+                range_first[ranges] = first < 256 ? 256 : first;
+                range_last[ranges] = last;
+                ++ranges;
+            }
+        }
     };
 
+    inline constexpr alphabet eng_alphabet{U'a', U'z'};
+
+    inline constexpr alphabet rus_alphabet{U'а', U'я', U'ё'};
+
+    inline constexpr alphabet ENG_alphabet{U'A', U'Z'};
+
+    inline constexpr alphabet RUS_alphabet{U'А', U'Я', U'Ё'};
+
     enum base_type {
         decimal = 10,
         octal = 8,
@@ -131,6 +192,33 @@ namespace inpch {
         }
     };
 
+    // Ввод *_input_loop кончился (EOF, закрытый канал) или поток сломан
+    class InputClosedException : public std::exception {
+    private:
+        std::string message;
+    public:
+        InputClosedException() { message = "Input stream is closed"; }
+
+        const char *what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+    template<class T>
+    inline constexpr bool is_string_input =
+            std::is_same<T, std::string>::value ||
+            std::is_same<T, std::wstring>::value ||
+            std::is_same<T, std::string_view>::value ||
+            std::is_same<T, std::wstring_view>::value;
+
+    template<class T>
+    inline constexpr bool is_number_input =
+            std::is_same<T, int>::value ||
+            std::is_same<T, float>::value ||
+            std::is_same<T, double>::value ||
+            std::is_same<T, long>::value ||
+            std::is_same<T, long long>::value;
+
     template<class T>
     bool is_hexadecimal(const T &str) noexcept;
 
@@ -143,12 +231,43 @@ namespace inpch {
     template<class T>
     bool is_octal(const T &str) noexcept;
 
+    template<class C>
+    std::size_t first_not_of_language(const C *data, std::size_t size, const language &lang) noexcept;
+
+    template<class C>
+    std::size_t first_not_of_base(const C *data, std::size_t size, const base_type &base) noexcept;
+
+    template<class T>
+    check_result check_base(const T &input, const int &length = any_length,
+                            const base_type &base = not_a_number) noexcept;
+
+    template<class T>
+    check_result check_language(const T &input, const language &lang) noexcept;
+
+    template<class T>
+    check_result check_range(const T &input, const T &left, const T &right, bool inside = true) noexcept;
+
+    check_result check_match(std::string_view input, const dfa &pattern) noexcept;
+    check_result check_match(const std::string &input, const std::regex &regex) noexcept;
+    // Через кэш результатов; regex должен жить дольше записей кэша
+    check_result check_match(const std::string &input, const std::regex &regex, result_cache &cache) noexcept;
+
     content_type content_type_of(const std::string &content_string);
     content_type content_type_of(const std::wstring  &content_string);
 
     bool input_match(const std::string &input_string, const std::string &regex_string);
+    bool input_match(const std::string &input_string, const std::string &regex_string,
+                     std::regex_constants::syntax_option_type flags);
     bool input_match(const std::string &input_string, const std::regex &regex);
-
+    bool input_match(std::string_view input_string, const dfa &pattern) noexcept;
+    bool input_match(std::string_view input_string, const dfa_pattern &pattern);
+    // Повторный вход стоит одного поиска в cache вместо разбора шаблоном
+    bool input_match(const std::string &input_string, const std::string &regex_string, result_cache &cache);
+    bool input_match(const std::string &input_string, const std::regex &regex, result_cache &cache);
+
+    // Читают std::cin (std::wcin), пока не придёт подходящее значение; в конце ввода
+    // бросают InputClosedException (без исключений - std::abort). Для каналов, ожидания
+    // с ограничением и сборки с -fno-exceptions - input_loop.h, он возвращает статус
     int int_input_loop(const int &l, const int &r, const std::string &err, bool in_range = true);
     int int_input_loop(const int &l, const int &r, const std::wstring &err, bool in_range = true);
 
@@ -166,333 +285,299 @@ namespace inpch {
 
         input_check(const T &input_string, const language &lang);
 
-        bool is_correct() { return correct; }
+        bool is_correct() const { return result.ok(); }
 
-        T get_value() { return value; }
+        const check_result &get_result() const { return result; }
 
-    private:
-        bool correct;
-        T value;
+        const T &get_value() const { return value; }
 
-        bool eng_lang_check(const T &str, ALPHA_SET(char) &alpha);
+        // Забирает значение без копирования; после вызова get_value() пуст
+        T release_value() { return std::move(value); }
 
-        bool rus_lang_check(const T &str, ALPHA_SET(CYRILLIC_CHAR_TYPE) &alpha);
+    private:
+        check_result result;
+        T value;
+    };
 
-        bool eng_lang_check(const T &str, ALPHA_SET(char) &alpha_upper, ALPHA_SET(char) &alpha_lower);
+    // Бросает исключение, которое конструкторы input_check бросали до появления check_*
+    inline void throw_on_misuse(const check_result &result, const char *name) {
+#ifdef INPCH_EXCEPTIONS
+        switch (result.error) {
+            case check_error::empty_input:
+                throw std::length_error(name);
+            case check_error::wrong_base:
+                throw WrongBaseException();
+            case check_error::wrong_language:
+                throw WrongLanguageException();
+            case check_error::wrong_type:
+                throw WrongTypeException();
+            default:
+                return;
+        }
+#else
+        (void) result;
+        (void) name;
+#endif
+    }
 
-        bool rus_lang_check(const T &str, ALPHA_SET(CYRILLIC_CHAR_TYPE) &alpha_upper,
-                            ALPHA_SET(CYRILLIC_CHAR_TYPE) &alpha_lower);
-    };
+    // Проверки без копирования: значение хранится как представление исходной строки,
+    // которая должна жить дольше объекта проверки
+    using input_check_view = input_check<std::string_view>;
+    using winput_check_view = input_check<std::wstring_view>;
 
     /* -------------------------------- Declarations -------------------------------- */
 
     template<class T>
-    input_check<T>::input_check(const T &input_string, const language &lang) {
-        if
-                (
-                std::is_same<T, std::string>::value ||
-                std::is_same<T, std::wstring>::value
-                ) {
-            if (input_string.empty()) throw std::length_error("input_string");
-
-            switch (lang) {
-                case rus:
-                    if (rus_lang_check(input_string, rus_alphabet)) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case eng:
-                    if (eng_lang_check(input_string, eng_alphabet)) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case RUS:
-                    if (rus_lang_check(input_string, RUS_alphabet)) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case ENG:
-                    if (eng_lang_check(input_string, ENG_alphabet)) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case Rus:
-                    if (rus_lang_check(input_string.substr(1), rus_alphabet) &&
-                        (RUS_alphabet.find(input_string[0]) != RUS_alphabet.end())) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case Eng:
-                    if (eng_lang_check(input_string.substr(1), eng_alphabet) &&
-                        (ENG_alphabet.find(input_string[0]) != ENG_alphabet.end())) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case RuS:
-                    if (rus_lang_check(input_string, RUS_alphabet, rus_alphabet)) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                case EnG:
-                    if (eng_lang_check(input_string, eng_alphabet, ENG_alphabet)) {
-                        value = input_string;
-                        correct = true;
-                        return;
-                    }
-                    correct = false;
-                    return;
-                default:
-                    throw WrongLanguageException();
-                    return;
-            }
+    input_check<T>::input_check(const T &input_string, const language &lang)
+            : result(stats::measure(stats::check_id::input_check_language, stats::bytes_of(input_string),
+                                    check_error::none, [&]() noexcept { return check_language(input_string, lang); })) {
+        throw_on_misuse(result, "input_string");
+        if (result.ok()) {
+            value = input_string;
         }
-        correct = false;
-        throw WrongTypeException();
     }
 
     template<class T>
-    input_check<T>::input_check(const T &input, const int &length, const base_type &base) {
-        if
-                (
-                std::is_same<T, std::string>::value ||
-                std::is_same<T, std::wstring>::value
-                ) {
-            if (input.empty()) throw std::length_error("input");
-            if (length != any_length) {
-                if (input.size() != length) {
-                    correct = false;
-                    return;
-                }
-            }
-            switch (base) {
-                case not_a_number:
-                    value = input;
-                    correct = true;
-                    return;
-                case decimal:
-                    correct = is_decimal(input);
-                    if (!correct) {
-                        return;
-                    }
-                    value = input;
-                    return;
-                case octal:
-                    correct = is_octal(input);
-                    if (!correct) {
-                        return;
-                    }
-                    value = input;
-                    return;
-                case hexadecimal:
-                    correct = is_hexadecimal(input);
-                    if (!correct) {
-                        return;
-                    }
-                    value = input;
-                    return;
-                case binary:
-                    correct = is_binary(input);
-                default:
-                    throw WrongBaseException();
-                    break;
-            }
+    input_check<T>::input_check(const T &input, const int &length, const base_type &base)
+            : result(stats::measure(stats::check_id::input_check_base, stats::bytes_of(input),
+                                    check_error::none, [&]() noexcept { return check_base(input, length, base); })) {
+        throw_on_misuse(result, "input");
+        if (result.ok()) {
+            value = input;
         }
-        correct = false;
-        throw WrongTypeException();
     }
 
     template<class T>
-    input_check<T>::input_check(const T &input, const T &left, const T &right, bool inside) {
-        if
-                (
-                std::is_same<T, int>::value ||
-                std::is_same<T, float>::value ||
-                std::is_same<T, double>::value ||
-                std::is_same<T, long>::value ||
-                std::is_same<T, long long>::value
-                ) {
-            if (inside) {
-                if (input >= left && input <= right) {
-                    correct = true;
-                    value = input;
-                    return;
-                }
-            }
-            if (input < left || input > right) {
-                correct = true;
-                value = input;
-                return;
-            }
+    input_check<T>::input_check(const T &input, const T &left, const T &right, bool inside)
+            : result(stats::measure(stats::check_id::input_check_range, stats::bytes_of(input),
+                                    check_error::none,
+                                    [&]() noexcept { return check_range(input, left, right, inside); })) {
+        throw_on_misuse(result, "input");
+        if (result.ok()) {
+            value = input;
         }
-        correct = false;
-        throw WrongTypeException();
     }
 
-    template<class T>
-    bool is_hexadecimal(const T &str) noexcept {
-        if
-                (
-                !(std::is_same<T, std::string>::value ||
-                  std::is_same<T, std::wstring>::value)
-                ) {
-            return false;
-        }
+    namespace check_detail {
+
+        // Широкие строки проверяются по кодовым единицам целиком (simd::all_of<Unit>),
+        // без усечения до char
 
-        for (size_t i = 0; i < str.size(); ++i) {
-            char c = str[i];
-            if (!isxdigit(c)) {
+        template<class T>
+        bool is_hexadecimal(const T &str) noexcept {
+            if constexpr (is_string_input<T>) {
+                return simd::all_of(str.data(), str.size(), simd::byte_class::hexadecimal);
+            } else {
                 return false;
             }
         }
 
-        return true;
-    }
+        template<class T>
+        bool is_binary(const T &str) noexcept {
+            if constexpr (is_string_input<T>) {
+                return simd::all_of(str.data(), str.size(), simd::byte_class::binary);
+            } else {
+                return false;
+            }
+        }
 
-    template<class T>
-    bool is_binary(const T &str) noexcept {
-        if
-                (
-                !(std::is_same<T, std::string>::value ||
-                  std::is_same<T, std::wstring>::value)
-                ) {
-            return false;
+        template<class T>
+        bool is_decimal(const T &str) noexcept {
+            if constexpr (is_string_input<T>) {
+                if (str.empty()) return false; // Пустая строка не является десятичным числом
+                size_t start = (str[0] == '+' || str[0] == '-') ? 1 : 0; // знак в начале строки
+                if (start == str.size()) return false; // строка состоит только из знака
+                return simd::all_of(str.data() + start, str.size() - start, simd::byte_class::decimal);
+            } else {
+                return false;
+            }
         }
 
-        for (size_t i = 0; i < str.size(); ++i) {
-            char c = str[i];
-            // Проверка, чтобы каждый символ был либо '0', либо '1'
-            if (c != '0' && c != '1') {
+        template<class T>
+        bool is_octal(const T &str) noexcept {
+            if constexpr (is_string_input<T>) {
+                return !str.empty() && simd::all_of(str.data(), str.size(), simd::byte_class::octal);
+            } else {
                 return false;
             }
         }
 
-        return true;
+    } // namespace check_detail
+
+    template<class T>
+    bool is_hexadecimal(const T &str) noexcept {
+        return stats::measure(stats::check_id::is_hexadecimal, stats::bytes_of(str),
+                              str.empty() ? check_error::empty_input : check_error::wrong_character,
+                              [&str]() noexcept { return check_detail::is_hexadecimal(str); });
+    }
+
+    template<class T>
+    bool is_binary(const T &str) noexcept {
+        return stats::measure(stats::check_id::is_binary, stats::bytes_of(str),
+                              str.empty() ? check_error::empty_input : check_error::wrong_character,
+                              [&str]() noexcept { return check_detail::is_binary(str); });
     }
 
     template<class T>
     bool is_decimal(const T &str) noexcept {
-        if
-                (
-                !(std::is_same<T, std::string>::value ||
-                  std::is_same<T, std::wstring>::value)
-                ) {
-            return false;
-        }
-        if (str.empty()) {
-            return false; // Пустая строка не является десятичным числом
-        }
+        return stats::measure(stats::check_id::is_decimal, stats::bytes_of(str),
+                              str.empty() ? check_error::empty_input : check_error::wrong_character,
+                              [&str]() noexcept { return check_detail::is_decimal(str); });
+    }
 
-        size_t start = 0;
-        if (str[0] == '+' || str[0] == '-') { // проверка на наличие знака в начале строки
-            if (str.length() == 1) {
-                return false; // строка состоит только из знака
-            }
-            start = 1; // начинаем проверку с следующего символа после знака
-        }
+    template<class T>
+    bool is_octal(const T &str) noexcept {
+        return stats::measure(stats::check_id::is_octal, stats::bytes_of(str),
+                              str.empty() ? check_error::empty_input : check_error::wrong_character,
+                              [&str]() noexcept { return check_detail::is_octal(str); });
+    }
 
-        for (size_t i = start; i < str.size(); ++i) {
-            if (!isdigit(str[i])) {
-                return false; // если текущий символ не является цифрой, то это не десятичное число
-            }
+    template<class C>
+    constexpr char32_t code_point(C ch) noexcept {
+        return static_cast<char32_t>(static_cast<std::make_unsigned_t<C>>(ch));
+    }
+
+    template<class C>
+    std::size_t first_not_of_alphabet(const C *data, std::size_t size, const alphabet &alpha) noexcept {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!alpha.contains(code_point(data[i]))) return i;
         }
+        return size;
+    }
 
-        return true; // все символы строки подходят под критерии десятичного числа
+    template<class C>
+    std::size_t first_not_of_alphabet(const C *data, std::size_t size, const alphabet &alpha_upper,
+                                      const alphabet &alpha_lower) noexcept {
+        for (std::size_t i = 0; i < size; ++i) {
+            char32_t ch = code_point(data[i]);
+            if (!alpha_upper.contains(ch) && !alpha_lower.contains(ch)) return i;
+        }
+        return size;
     }
 
-    template<class T>
-    bool is_octal(const T &str) noexcept {
-        if
-                (
-                !(std::is_same<T, std::string>::value ||
-                  std::is_same<T, std::wstring>::value)
-                ) {
-            return false;
+    // Индекс первого символа, не подходящего под язык, либо size. Узкие строки
+    // считаются UTF-8: кириллица проверяется по парам байтов, индекс - в байтах.
+    // Широкие строки проверяются по кодовым единицам
+    template<class C>
+    std::size_t first_not_of_language(const C *data, std::size_t size, const language &lang) noexcept {
+        // Сколько единиц занимает кириллическая буква
+        constexpr std::size_t letter = std::is_same<C, char>::value ? 2 : 1;
+        switch (lang) {
+            case rus:
+                return simd::first_not_cyrillic(data, size, simd::cyrillic_class::lower);
+            case eng:
+                return simd::first_not_of(data, size, simd::byte_class::lower);
+            case RUS:
+                return simd::first_not_cyrillic(data, size, simd::cyrillic_class::upper);
+            case ENG:
+                return simd::first_not_of(data, size, simd::byte_class::upper);
+            case Rus:
+                if (simd::first_not_cyrillic(data, size < letter ? size : letter, simd::cyrillic_class::upper) != letter) {
+                    return 0;
+                }
+                return letter + simd::first_not_cyrillic(data + letter, size - letter, simd::cyrillic_class::lower);
+            case Eng:
+                if (size == 0 || !simd::in_class(code_point(data[0]), simd::byte_class::upper)) return 0;
+                return 1 + simd::first_not_of(data + 1, size - 1, simd::byte_class::lower);
+            case RuS:
+                return simd::first_not_cyrillic(data, size, simd::cyrillic_class::alpha);
+            case EnG:
+                return simd::first_not_of(data, size, simd::byte_class::alpha);
+            default:
+                return 0;
         }
-        if (str.empty()) {
-            return false; // Пустая строка не является восьмеричным числом
+    }
+
+    template<class C>
+    std::size_t first_not_of_base(const C *data, std::size_t size, const base_type &base) noexcept {
+        std::size_t start = 0;
+        if (base == decimal && size > 0 && (data[0] == '+' || data[0] == '-')) {
+            if (size == 1) return 0;
+            start = 1;
         }
 
-        for (size_t i = 0; i < str.size(); ++i) {
-            char c = str[i];
-            if (c < '0' || c > '7') {
-                return false; // если символ не в диапазоне от '0' до '7'
-            }
+        simd::byte_class cls;
+        switch (base) {
+            case decimal:
+                cls = simd::byte_class::decimal;
+                break;
+            case octal:
+                cls = simd::byte_class::octal;
+                break;
+            case hexadecimal:
+                cls = simd::byte_class::hexadecimal;
+                break;
+            case binary:
+                cls = simd::byte_class::binary;
+                break;
+            default:
+                return size;
         }
 
-        return true; // все символы строки подходят под критерии восьмеричного числа
+        return start + simd::first_not_of(data + start, size - start, cls);
     }
 
     template<class T>
-    bool input_check<T>::eng_lang_check(const T &str, ALPHA_SET(char) &alpha) {
-        if
-                (
-                std::all_of(str.begin(), str.end(),
-                            [&alpha](char ch) {
-                                return alpha.find(ch) != alpha.end();
-                            })
-                ) {
-            return true;
+    check_result check_base(const T &input, const int &length, const base_type &base) noexcept {
+        if constexpr (!is_string_input<T>) {
+            return {0, check_error::wrong_type};
         } else {
-            return false;
+            if (input.empty()) return {0, check_error::empty_input};
+            if (length != any_length && input.size() != static_cast<std::size_t>(length)) {
+                std::size_t expected = length < 0 ? 0 : static_cast<std::size_t>(length);
+                return {std::min(input.size(), expected), check_error::wrong_length};
+            }
+            switch (base) {
+                case not_a_number:
+                    return {input.size(), check_error::none};
+                case decimal:
+                case octal:
+                case hexadecimal:
+                case binary: {
+                    std::size_t bad = first_not_of_base(input.data(), input.size(), base);
+                    if (bad != input.size()) return {bad, check_error::wrong_character};
+                    return {input.size(), check_error::none};
+                }
+                default:
+                    return {input.size(), check_error::wrong_base};
+            }
         }
     }
 
     template<class T>
-    bool input_check<T>::rus_lang_check(const T &str, ALPHA_SET(CYRILLIC_CHAR_TYPE) &alpha) {
-        if
-                (
-                std::all_of(str.begin(), str.end(),
-                            [&alpha](CYRILLIC_CHAR_TYPE ch) {
-                                return alpha.find(ch) != alpha.end();
-                            })
-                ) {
-            return true;
+    check_result check_language(const T &input, const language &lang) noexcept {
+        if constexpr (!is_string_input<T>) {
+            return {0, check_error::wrong_type};
         } else {
-            return false;
-        }
-    }
-
-    template<class T>
-    bool
-    input_check<T>::eng_lang_check(const T &str, ALPHA_SET(char) &alpha_upper, ALPHA_SET(char) &alpha_lower) {
-        for (const auto &ch: str) {
-            if (alpha_upper.find(ch) == alpha_upper.end() || alpha_lower.find(ch) == alpha_lower.end()) {
-                return false;
+            if (input.empty()) return {0, check_error::empty_input};
+            switch (lang) {
+                case rus:
+                case eng:
+                case RUS:
+                case ENG:
+                case Rus:
+                case Eng:
+                case RuS:
+                case EnG: {
+                    std::size_t bad = first_not_of_language(input.data(), input.size(), lang);
+                    if (bad != input.size()) return {bad, check_error::wrong_character};
+                    return {input.size(), check_error::none};
+                }
+                default:
+                    return {input.size(), check_error::wrong_language};
             }
         }
-        return true;
     }
 
     template<class T>
-    bool input_check<T>::rus_lang_check(const T &str, ALPHA_SET(CYRILLIC_CHAR_TYPE) &alpha_upper,
-                                        ALPHA_SET(CYRILLIC_CHAR_TYPE) &alpha_lower) {
-        for (const auto &ch: str) {
-            if (alpha_upper.find(ch) == alpha_upper.end() || alpha_lower.find(ch) == alpha_lower.end()) {
-                return false;
-            }
+    check_result check_range(const T &input, const T &left, const T &right, bool inside) noexcept {
+        if constexpr (!is_number_input<T>) {
+            return {0, check_error::wrong_type};
+        } else {
+            // Для NaN оба сравнения ложны, поэтому NaN не проходит ни inside, ни outside
+            bool accepted = inside ? (input >= left && input <= right) : (input < left || input > right);
+            return {0, accepted ? check_error::none : check_error::out_of_range};
         }
-        return true;
     }
 
 } // inpch
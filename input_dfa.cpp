@@ -0,0 +1,551 @@
+#include "input_dfa.h"
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+
+namespace inpch {
+
+    namespace {
+
+        using char_set = std::bitset<256>;
+
+        // Максимум состояний ДКА; шаблоны крупнее отвергаются
+        constexpr std::size_t max_dfa_states = 1u << 16;
+
+        // Максимум копий подвыражения при раскрытии {n,m}
+        constexpr int max_repeat = 1024;
+
+        struct node {
+            enum kind_type {
+                empty,
+                chars,
+                concat,
+                alternation,
+                repeat
+            } kind;
+            char_set set;
+            std::vector<node> children;
+            int min = 0;
+            int max = 0; // -1 - без ограничения
+        };
+
+        class parser {
+        public:
+            explicit parser(std::string_view pattern) : text(pattern) {}
+
+            node parse() {
+                node result = parse_alternation(true);
+                if (pos != text.size()) fail("unbalanced ')'");
+                return result;
+            }
+
+        private:
+            std::string_view text;
+            std::size_t pos = 0;
+
+            [[noreturn]] void fail(const std::string &reason) const {
+                throw WrongPatternException(reason + " at position " + std::to_string(pos));
+            }
+
+            bool at_end() const { return pos >= text.size(); }
+
+            char peek() const { return text[pos]; }
+
+            node parse_alternation(bool top_level) {
+                node first = parse_concat(top_level);
+                if (at_end() || peek() != '|') return first;
+
+                node alt{node::alternation, {}, {}};
+                alt.children.push_back(std::move(first));
+                while (!at_end() && peek() == '|') {
+                    ++pos;
+                    alt.children.push_back(parse_concat(top_level));
+                }
+                return alt;
+            }
+
+            node parse_concat(bool top_level) {
+                node seq{node::concat, {}, {}};
+                // ^ и $ допустимы только на краях шаблона, где при полном сопоставлении они всегда истинны
+                if (top_level && !at_end() && peek() == '^') ++pos;
+                while (!at_end() && peek() != '|' && peek() != ')') {
+                    if (peek() == '$') {
+                        ++pos;
+                        if (top_level && (at_end() || peek() == '|')) break;
+                        fail("'$' inside the pattern");
+                    }
+                    seq.children.push_back(parse_quantified());
+                }
+                if (seq.children.size() == 1) return std::move(seq.children.front());
+                if (seq.children.empty()) return node{node::empty, {}, {}};
+                return seq;
+            }
+
+            node parse_quantified() {
+                node atom = parse_atom();
+                while (!at_end()) {
+                    int min, max;
+                    char c = peek();
+                    if (c == '*') {
+                        min = 0, max = -1;
+                        ++pos;
+                    } else if (c == '+') {
+                        min = 1, max = -1;
+                        ++pos;
+                    } else if (c == '?') {
+                        min = 0, max = 1;
+                        ++pos;
+                    } else if (c == '{') {
+                        parse_bounds(min, max);
+                    } else {
+                        break;
+                    }
+                    // Ленивый квантификатор не влияет на результат полного сопоставления
+                    if (!at_end() && peek() == '?') ++pos;
+
+                    node rep{node::repeat, {}, {}};
+                    rep.min = min;
+                    rep.max = max;
+                    rep.children.push_back(std::move(atom));
+                    atom = std::move(rep);
+                }
+                return atom;
+            }
+
+            int parse_int() {
+                if (at_end() || peek() < '0' || peek() > '9') fail("expected a number");
+                int value = 0;
+                while (!at_end() && peek() >= '0' && peek() <= '9') {
+                    value = value * 10 + (peek() - '0');
+                    if (value > max_repeat) fail("repetition count is too large");
+                    ++pos;
+                }
+                return value;
+            }
+
+            void parse_bounds(int &min, int &max) {
+                ++pos; // {
+                min = parse_int();
+                max = min;
+                if (!at_end() && peek() == ',') {
+                    ++pos;
+                    max = (!at_end() && peek() == '}') ? -1 : parse_int();
+                }
+                if (at_end() || peek() != '}') fail("expected '}'");
+                ++pos;
+                if (max != -1 && max < min) fail("invalid repetition bounds");
+            }
+
+            node parse_atom() {
+                char c = peek();
+                switch (c) {
+                    case '(': {
+                        ++pos;
+                        if (!at_end() && peek() == '?') {
+                            if (pos + 1 < text.size() && text[pos + 1] == ':') {
+                                pos += 2;
+                            } else {
+                                fail("lookahead");
+                            }
+                        }
+                        node inner = parse_alternation(false);
+                        if (at_end() || peek() != ')') fail("expected ')'");
+                        ++pos;
+                        return inner;
+                    }
+                    case '[':
+                        return chars(parse_class());
+                    case '.': {
+                        ++pos;
+                        char_set any;
+                        any.set();
+                        any.reset('\n');
+                        any.reset('\r');
+                        return chars(any);
+                    }
+                    case '\\':
+                        ++pos;
+                        return chars(parse_escape(false));
+                    case '*':
+                    case '+':
+                    case '?':
+                    case '{':
+                        fail("nothing to repeat");
+                    case '^':
+                        fail("'^' inside the pattern");
+                    default: {
+                        ++pos;
+                        char_set one;
+                        one.set(static_cast<unsigned char>(c));
+                        return chars(one);
+                    }
+                }
+            }
+
+            static node chars(const char_set &set) {
+                node n{node::chars, set, {}};
+                return n;
+            }
+
+            static char_set range(unsigned char first, unsigned char last) {
+                char_set set;
+                for (unsigned c = first; c <= last; ++c) set.set(c);
+                return set;
+            }
+
+            static unsigned char single_char(const char_set &set) {
+                unsigned c = 0;
+                while (!set[c]) ++c;
+                return static_cast<unsigned char>(c);
+            }
+
+            static char_set digits() { return range('0', '9'); }
+
+            static char_set word() { return range('a', 'z') | range('A', 'Z') | digits() | range('_', '_'); }
+
+            static char_set spaces() { return range('\t', '\r') | range(' ', ' '); }
+
+            int hex_digit(char c) const {
+                if (c >= '0' && c <= '9') return c - '0';
+                if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+                if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+                fail("invalid \\x escape");
+            }
+
+            // Разбирает символ после '\'; in_class - внутри [...]
+            char_set parse_escape(bool in_class) {
+                if (at_end()) fail("trailing '\\'");
+                char c = text[pos++];
+                switch (c) {
+                    case 'd':
+                        return digits();
+                    case 'D':
+                        return ~digits();
+                    case 'w':
+                        return word();
+                    case 'W':
+                        return ~word();
+                    case 's':
+                        return spaces();
+                    case 'S':
+                        return ~spaces();
+                    case 't':
+                        return range('\t', '\t');
+                    case 'n':
+                        return range('\n', '\n');
+                    case 'r':
+                        return range('\r', '\r');
+                    case 'f':
+                        return range('\f', '\f');
+                    case 'v':
+                        return range('\v', '\v');
+                    case '0':
+                        return range(0, 0);
+                    case 'b':
+                        if (in_class) return range('\b', '\b');
+                        fail("word boundary");
+                    case 'B':
+                        fail("word boundary");
+                    case 'x': {
+                        if (pos + 2 > text.size()) fail("invalid \\x escape");
+                        int value = hex_digit(text[pos]) * 16 + hex_digit(text[pos + 1]);
+                        pos += 2;
+                        return range(static_cast<unsigned char>(value), static_cast<unsigned char>(value));
+                    }
+                    default:
+                        if (c >= '1' && c <= '9') fail("backreference");
+                        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) fail(std::string("escape \\") + c);
+                        return range(static_cast<unsigned char>(c), static_cast<unsigned char>(c));
+                }
+            }
+
+            char_set parse_class() {
+                ++pos; // [
+                bool negate = false;
+                if (!at_end() && peek() == '^') {
+                    negate = true;
+                    ++pos;
+                }
+
+                char_set set;
+                while (true) {
+                    if (at_end()) fail("expected ']'");
+                    if (peek() == ']') {
+                        ++pos;
+                        break;
+                    }
+
+                    // Одиночный символ или escape-класс
+                    char_set item;
+                    bool single = true;
+                    unsigned char first = 0;
+                    if (peek() == '\\') {
+                        ++pos;
+                        item = parse_escape(true);
+                        single = item.count() == 1;
+                        if (single) first = single_char(item);
+                    } else {
+                        first = static_cast<unsigned char>(text[pos++]);
+                        item.set(first);
+                    }
+
+                    // Диапазон a-z; '-' перед ']' - литерал
+                    if (single && pos + 1 < text.size() && peek() == '-' && text[pos + 1] != ']') {
+                        ++pos;
+                        unsigned char last;
+                        if (peek() == '\\') {
+                            ++pos;
+                            char_set end = parse_escape(true);
+                            if (end.count() != 1) fail("invalid class range");
+                            last = single_char(end);
+                        } else {
+                            last = static_cast<unsigned char>(text[pos++]);
+                        }
+                        if (last < first) fail("invalid class range");
+                        item = range(first, last);
+                    }
+                    set |= item;
+                }
+                return negate ? ~set : set;
+            }
+        };
+
+        // НКА Томпсона: у состояния либо один переход по множеству символов, либо эпсилон-переходы
+        struct nfa {
+            struct state {
+                int set = -1;
+                int next = -1;
+                std::vector<int> epsilon;
+            };
+
+            std::vector<state> states;
+            std::vector<char_set> sets;
+            int start = 0;
+            // accepts[k] - принимающее состояние шаблона k
+            std::vector<int> accepts;
+
+            int add_state() {
+                states.emplace_back();
+                return static_cast<int>(states.size()) - 1;
+            }
+
+            // Строит фрагмент для n между состояниями from и to
+            void emit(const node &n, int from, int to) {
+                switch (n.kind) {
+                    case node::empty:
+                        states[from].epsilon.push_back(to);
+                        return;
+                    case node::chars:
+                        sets.push_back(n.set);
+                        states[from].set = static_cast<int>(sets.size()) - 1;
+                        states[from].next = to;
+                        return;
+                    case node::concat: {
+                        int current = from;
+                        for (std::size_t i = 0; i < n.children.size(); ++i) {
+                            int next = i + 1 == n.children.size() ? to : add_state();
+                            int entry = add_state();
+                            states[current].epsilon.push_back(entry);
+                            emit(n.children[i], entry, next);
+                            current = next;
+                        }
+                        return;
+                    }
+                    case node::alternation:
+                        for (const node &child: n.children) {
+                            int entry = add_state();
+                            states[from].epsilon.push_back(entry);
+                            emit(child, entry, to);
+                        }
+                        return;
+                    case node::repeat: {
+                        const node &body = n.children.front();
+                        int current = from;
+                        for (int i = 0; i < n.min; ++i) {
+                            int entry = add_state(), next = add_state();
+                            states[current].epsilon.push_back(entry);
+                            emit(body, entry, next);
+                            current = next;
+                        }
+                        if (n.max == -1) {
+                            int loop = add_state(), entry = add_state();
+                            states[current].epsilon.push_back(loop);
+                            states[loop].epsilon.push_back(entry);
+                            states[loop].epsilon.push_back(to);
+                            emit(body, entry, loop);
+                            return;
+                        }
+                        for (int i = n.min; i < n.max; ++i) {
+                            int entry = add_state(), next = add_state();
+                            states[current].epsilon.push_back(entry);
+                            states[current].epsilon.push_back(to);
+                            emit(body, entry, next);
+                            current = next;
+                        }
+                        states[current].epsilon.push_back(to);
+                        return;
+                    }
+                }
+            }
+
+            void closure(std::vector<int> &set, std::vector<std::uint8_t> &seen) const {
+                std::vector<int> stack(set.begin(), set.end());
+                for (int s: set) seen[s] = 1;
+                while (!stack.empty()) {
+                    int s = stack.back();
+                    stack.pop_back();
+                    for (int t: states[s].epsilon) {
+                        if (!seen[t]) {
+                            seen[t] = 1;
+                            set.push_back(t);
+                            stack.push_back(t);
+                        }
+                    }
+                }
+                for (int s: set) seen[s] = 0;
+                std::sort(set.begin(), set.end());
+            }
+        };
+
+        // Таблицы ДКА для одного или нескольких шаблонов: в accepting для каждого
+        // состояния хранится маска шаблонов, которые принимают вход в этом состоянии
+        struct tables {
+            std::uint8_t byte_classes[256];
+            std::uint32_t class_count;
+            std::vector<std::uint32_t> transitions;
+            std::vector<std::uint64_t> accepting;
+            std::uint32_t start;
+        };
+
+        tables build(const std::vector<std::string_view> &patterns) {
+            nfa automaton;
+            automaton.start = automaton.add_state();
+            for (std::string_view pattern: patterns) {
+                node root = parser(pattern).parse();
+                int entry = automaton.add_state(), accept = automaton.add_state();
+                automaton.states[automaton.start].epsilon.push_back(entry);
+                automaton.emit(root, entry, accept);
+                automaton.accepts.push_back(accept);
+            }
+            std::vector<int> pattern_of(automaton.states.size(), -1);
+            for (std::size_t k = 0; k < automaton.accepts.size(); ++k) {
+                pattern_of[automaton.accepts[k]] = static_cast<int>(k);
+            }
+
+            tables result;
+
+            // Байты с одинаковой принадлежностью ко всем множествам шаблонов неразличимы
+            std::uint8_t classes[256] = {};
+            std::uint32_t count = 1;
+            for (const char_set &set: automaton.sets) {
+                std::map<std::pair<std::uint8_t, bool>, std::uint8_t> split;
+                std::uint32_t next_count = 0;
+                for (int c = 0; c < 256; ++c) {
+                    auto key = std::make_pair(classes[c], static_cast<bool>(set[c]));
+                    auto it = split.find(key);
+                    if (it == split.end()) it = split.emplace(key, static_cast<std::uint8_t>(next_count++)).first;
+                    classes[c] = it->second;
+                }
+                count = next_count;
+            }
+            std::vector<unsigned char> representative(count);
+            for (int c = 255; c >= 0; --c) representative[classes[c]] = static_cast<unsigned char>(c);
+            std::copy(std::begin(classes), std::end(classes), result.byte_classes);
+            result.class_count = count;
+
+            // Построение подмножеств; состояние 0 - пустое множество (тупик)
+            std::vector<std::uint8_t> seen(automaton.states.size());
+            std::map<std::vector<int>, std::uint32_t> index;
+            std::vector<std::vector<int>> pending;
+
+            auto intern = [&](std::vector<int> &&set) -> std::uint32_t {
+                auto it = index.find(set);
+                if (it != index.end()) return it->second * count;
+                if (result.accepting.size() >= max_dfa_states) throw WrongPatternException("automaton is too large");
+                auto id = static_cast<std::uint32_t>(result.accepting.size());
+                std::uint64_t mask = 0;
+                for (int s: set) {
+                    if (pattern_of[s] != -1) mask |= std::uint64_t{1} << pattern_of[s];
+                }
+                result.accepting.push_back(mask);
+                result.transitions.resize(result.transitions.size() + count, dfa::dead_state);
+                index.emplace(set, id);
+                pending.push_back(std::move(set));
+                return id * count;
+            };
+
+            intern({});
+            pending.clear();
+            std::vector<int> initial{automaton.start};
+            automaton.closure(initial, seen);
+            result.start = intern(std::move(initial));
+
+            for (std::uint32_t id = 1; id < result.accepting.size(); ++id) {
+                std::vector<int> current = std::move(pending[id - 1]);
+                for (std::uint32_t cls = 0; cls < count; ++cls) {
+                    std::vector<int> next;
+                    for (int s: current) {
+                        const auto &st = automaton.states[s];
+                        if (st.set != -1 && automaton.sets[st.set][representative[cls]]) next.push_back(st.next);
+                    }
+                    if (next.empty()) continue;
+                    std::sort(next.begin(), next.end());
+                    next.erase(std::unique(next.begin(), next.end()), next.end());
+                    automaton.closure(next, seen);
+                    result.transitions[id * count + cls] = intern(std::move(next));
+                }
+            }
+            return result;
+        }
+
+    } // namespace
+
+    dfa::dfa(std::string_view pattern) {
+        tables built = build({pattern});
+        std::copy(std::begin(built.byte_classes), std::end(built.byte_classes), byte_classes);
+        class_count = built.class_count;
+        transitions = std::move(built.transitions);
+        accepting.assign(built.accepting.begin(), built.accepting.end());
+        start = built.start;
+    }
+
+    pattern_set::pattern_set(const std::vector<std::string_view> &patterns) {
+        if (patterns.size() > max_patterns) throw WrongPatternException("too many patterns in a set");
+        tables built = build(patterns);
+        std::copy(std::begin(built.byte_classes), std::end(built.byte_classes), byte_classes);
+        class_count = built.class_count;
+        transitions = std::move(built.transitions);
+        accepting = std::move(built.accepting);
+        start = built.start;
+        patterns_count = patterns.size();
+    }
+
+    pattern_set::pattern_set(std::initializer_list<std::reference_wrapper<const dfa_pattern>> patterns)
+            : pattern_set(sources_of(patterns)) {}
+
+    std::vector<std::string_view> pattern_set::sources_of(
+            std::initializer_list<std::reference_wrapper<const dfa_pattern>> patterns) {
+        std::vector<std::string_view> sources;
+        sources.reserve(patterns.size());
+        for (const dfa_pattern &pattern: patterns) sources.emplace_back(pattern.pattern());
+        return sources;
+    }
+
+    std::size_t pattern_set::first_match(std::string_view input) const noexcept {
+        mask_type mask = match(input);
+        if (mask == 0) return npos;
+        std::size_t k = 0;
+        while (!((mask >> k) & 1u)) ++k;
+        return k;
+    }
+
+    const dfa &dfa_pattern::compile() const {
+        std::call_once(once, [this] {
+            storage = std::make_unique<dfa>(source);
+            compiled.store(storage.get(), std::memory_order_release);
+        });
+        return *storage;
+    }
+
+} // inpch
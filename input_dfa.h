@@ -0,0 +1,159 @@
+#ifndef INPUTCHECK_INPUT_DFA_H
+#define INPUTCHECK_INPUT_DFA_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inpch {
+
+    class WrongPatternException : public std::exception {
+    private:
+        std::string message;
+    public:
+        explicit WrongPatternException(const std::string &reason) { message = "Unsupported pattern: " + reason; }
+
+        const char *what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+    // Таблично-управляемый ДКА, собранный из подмножества синтаксиса ECMAScript:
+    // литералы, экранирование, классы [...] и \d \w \s, '.', группы (...) и (?:...),
+    // '|', квантификаторы * + ? {n} {n,} {n,m} (ленивые считаются жадными),
+    // а также ^ и $ на краях шаблона. Обратные ссылки и lookahead не поддерживаются.
+    // Сопоставление всегда полное, как у std::regex_match.
+    class dfa {
+    public:
+        using state_type = std::uint32_t;
+
+        static constexpr state_type dead_state = 0;
+
+        explicit dfa(std::string_view pattern);
+
+        state_type start_state() const noexcept { return start; }
+
+        // Продолжает разбор с состояния state; позволяет подавать вход частями
+        state_type advance(state_type state, std::string_view chunk) const noexcept {
+            for (unsigned char ch: chunk) {
+                state = transitions[state + byte_classes[ch]];
+                if (state == dead_state) break;
+            }
+            return state;
+        }
+
+        // Как advance, но возвращает индекс байта, на котором разбор попал в мёртвое
+        // состояние (или размер chunk); state обновляется
+        std::size_t advance_until_dead(state_type &state, std::string_view chunk) const noexcept {
+            for (std::size_t i = 0; i < chunk.size(); ++i) {
+                state = transitions[state + byte_classes[static_cast<unsigned char>(chunk[i])]];
+                if (state == dead_state) return i;
+            }
+            return chunk.size();
+        }
+
+        bool is_accepting(state_type state) const noexcept { return accepting[state / class_count] != 0; }
+
+        bool match(std::string_view input) const noexcept { return is_accepting(advance(start, input)); }
+
+        std::size_t state_count() const noexcept { return accepting.size(); }
+
+    private:
+        std::uint8_t byte_classes[256];
+        std::uint32_t class_count;
+        // Переходы хранятся со смещением строки (state * class_count), чтобы шаг был одним сложением
+        std::vector<state_type> transitions;
+        std::vector<std::uint8_t> accepting;
+        state_type start;
+    };
+
+    // Шаблон, который компилируется в dfa при первом использовании
+    class dfa_pattern {
+    public:
+        constexpr explicit dfa_pattern(const char *pattern) noexcept : source(pattern) {}
+
+        dfa_pattern(const dfa_pattern &) = delete;
+
+        dfa_pattern &operator=(const dfa_pattern &) = delete;
+
+        const dfa &get() const {
+            if (const dfa *ready = compiled.load(std::memory_order_acquire)) return *ready;
+            return compile();
+        }
+
+        bool match(std::string_view input) const { return get().match(input); }
+
+        const char *pattern() const noexcept { return source; }
+
+    private:
+        const char *source;
+        mutable std::once_flag once;
+        mutable std::unique_ptr<dfa> storage;
+        mutable std::atomic<const dfa *> compiled{nullptr};
+
+        const dfa &compile() const;
+    };
+
+    // Несколько шаблонов (синтаксис как у dfa), собранных в один автомат: за один
+    // проход по входу находятся все шаблоны, которым он соответствует целиком.
+    // Число состояний ограничено так же, как у dfa; шаблоны, дающие вместе слишком
+    // большой автомат, отвергаются WrongPatternException.
+    class pattern_set {
+    public:
+        using mask_type = std::uint64_t;
+        using state_type = dfa::state_type;
+
+        static constexpr std::size_t max_patterns = 64;
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        // Бит k результата соответствует patterns[k]
+        explicit pattern_set(const std::vector<std::string_view> &patterns);
+
+        // Готовые шаблоны, например {rgxp::dfa::email, rgxp::dfa::url}
+        pattern_set(std::initializer_list<std::reference_wrapper<const dfa_pattern>> patterns);
+
+        std::size_t size() const noexcept { return patterns_count; }
+
+        state_type start_state() const noexcept { return start; }
+
+        // Продолжает разбор с состояния state; позволяет подавать вход частями
+        state_type advance(state_type state, std::string_view chunk) const noexcept {
+            for (unsigned char ch: chunk) {
+                state = transitions[state + byte_classes[ch]];
+                if (state == dfa::dead_state) break;
+            }
+            return state;
+        }
+
+        // Шаблоны, которые принимают вход, прочитанный до состояния state
+        mask_type accepted(state_type state) const noexcept { return accepting[state / class_count]; }
+
+        mask_type match(std::string_view input) const noexcept { return accepted(advance(start, input)); }
+
+        // Номер первого подходящего шаблона или npos
+        std::size_t first_match(std::string_view input) const noexcept;
+
+        std::size_t state_count() const noexcept { return accepting.size(); }
+
+    private:
+        std::uint8_t byte_classes[256];
+        std::uint32_t class_count;
+        std::vector<state_type> transitions;
+        std::vector<mask_type> accepting;
+        state_type start;
+        std::size_t patterns_count;
+
+        static std::vector<std::string_view> sources_of(
+                std::initializer_list<std::reference_wrapper<const dfa_pattern>> patterns);
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_INPUT_DFA_H
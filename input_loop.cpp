@@ -0,0 +1,234 @@
+#include "input_loop.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace inpch {
+
+    namespace {
+
+        template<class CharT>
+        std::basic_string_view<CharT> strip_cr(std::basic_string_view<CharT> line) noexcept {
+            if (!line.empty() && line.back() == CharT('\r')) line.remove_suffix(1);
+            return line;
+        }
+
+    } // namespace
+
+    template<class CharT>
+    basic_line_reader<CharT>::basic_line_reader(std::basic_istream<CharT> &in, std::size_t buffer_size)
+            : buffer(new CharT[std::max<std::size_t>(buffer_size, 64)]),
+              capacity(std::max<std::size_t>(buffer_size, 64)),
+              stream(in.rdbuf()) {}
+
+    template<class CharT>
+    template<class C, class>
+    basic_line_reader<CharT>::basic_line_reader(int fd, std::size_t buffer_size)
+            : buffer(new CharT[std::max<std::size_t>(buffer_size, 64)]),
+              capacity(std::max<std::size_t>(buffer_size, 64)),
+              fd(fd) {}
+
+    template<class CharT>
+    read_status basic_line_reader<CharT>::next(view_type &line, int timeout_ms) {
+        while (true) {
+            const CharT *found = std::char_traits<CharT>::find(buffer.get() + scanned, end - scanned, CharT('\n'));
+            if (found) {
+                const auto at = static_cast<std::size_t>(found - buffer.get());
+                line = strip_cr(view_type(buffer.get() + begin, at - begin));
+                begin = scanned = at + 1;
+                ++lines_read;
+                return read_status::line;
+            }
+            scanned = end;
+            if (finished) {
+                if (begin == end) return read_status::eof;
+                // Последняя строка без '\n'
+                line = strip_cr(view_type(buffer.get() + begin, end - begin));
+                begin = end;
+                ++lines_read;
+                return read_status::line;
+            }
+            const read_status status = fill(timeout_ms);
+            if (status == read_status::eof) {
+                finished = true;
+            } else if (status != read_status::line) {
+                return status;
+            }
+        }
+    }
+
+    template<class CharT>
+    read_status basic_line_reader<CharT>::next_block(view_type &lines, int timeout_ms) {
+        while (true) {
+            // Последний '\n' ищется с конца: обычно он в последней строке буфера
+            std::size_t at = end;
+            while (at > scanned && buffer[at - 1] != CharT('\n')) --at;
+            if (at > scanned) {
+                lines = view_type(buffer.get() + begin, at - begin);
+                begin = scanned = at;
+                return read_status::line;
+            }
+            scanned = end;
+            if (finished) {
+                if (begin == end) return read_status::eof;
+                lines = view_type(buffer.get() + begin, end - begin);
+                begin = end;
+                return read_status::line;
+            }
+            const read_status status = fill(timeout_ms);
+            if (status == read_status::eof) {
+                finished = true;
+            } else if (status != read_status::line) {
+                return status;
+            }
+        }
+    }
+
+    // Дочитывает в конец буфера; read_status::line - данные пришли
+    template<class CharT>
+    read_status basic_line_reader<CharT>::fill(int timeout_ms) {
+        // Выданные строки больше не нужны: остаток переносится в начало
+        if (begin > 0) {
+            std::char_traits<CharT>::move(buffer.get(), buffer.get() + begin, end - begin);
+            end -= begin;
+            scanned -= begin;
+            begin = 0;
+        }
+        // Строка не помещается в буфер
+        if (end == capacity) {
+            std::unique_ptr<CharT[]> wider(new CharT[capacity * 2]);
+            std::char_traits<CharT>::copy(wider.get(), buffer.get(), end);
+            buffer = std::move(wider);
+            capacity *= 2;
+        }
+        return stream ? fill_stream() : fill_fd(timeout_ms);
+    }
+
+    template<class CharT>
+    read_status basic_line_reader<CharT>::fill_fd(int timeout_ms) {
+        if constexpr (std::is_same<CharT, char>::value) {
+#if defined(_WIN32)
+            (void) timeout_ms;
+            while (true) {
+                const int got = ::_read(fd, buffer.get() + end,
+                                        static_cast<unsigned>(std::min<std::size_t>(capacity - end, 1u << 30)));
+                if (got > 0) {
+                    end += static_cast<std::size_t>(got);
+                    return read_status::line;
+                }
+                if (got == 0) return read_status::eof;
+                if (errno == EINTR) continue;
+                error = errno;
+                return read_status::error;
+            }
+#else
+            // Без ограничения по времени read блокируется сам; poll нужен для
+            // ограничения и для неблокирующего дескриптора
+            bool wait = timeout_ms >= 0;
+            while (true) {
+                if (wait) {
+                    pollfd watched{fd, POLLIN, 0};
+                    const int ready = ::poll(&watched, 1, timeout_ms);
+                    if (ready == 0) return read_status::timeout;
+                    if (ready < 0) {
+                        if (errno == EINTR) continue;
+                        error = errno;
+                        return read_status::error;
+                    }
+                }
+                const ssize_t got = ::read(fd, buffer.get() + end, capacity - end);
+                if (got > 0) {
+                    end += static_cast<std::size_t>(got);
+                    return read_status::line;
+                }
+                if (got == 0) return read_status::eof;
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    wait = true;
+                    continue;
+                }
+                error = errno;
+                return read_status::error;
+            }
+#endif
+        } else {
+            (void) timeout_ms;
+            return read_status::error;
+        }
+    }
+
+    // Из потока берётся всё, что уже есть в его буфере; если там пусто -
+    // один символ с ожиданием, чтобы не ждать заполнения всего нашего буфера
+    template<class CharT>
+    read_status basic_line_reader<CharT>::fill_stream() {
+        using traits = std::char_traits<CharT>;
+        std::streamsize available = stream->in_avail();
+        if (available < 0) return read_status::eof;
+        if (available == 0) {
+            const auto ch = stream->sbumpc();
+            if (traits::eq_int_type(ch, traits::eof())) return read_status::eof;
+            buffer[end++] = traits::to_char_type(ch);
+            available = stream->in_avail();
+            if (available <= 0) return read_status::line;
+        }
+        const auto room = static_cast<std::streamsize>(capacity - end);
+        end += static_cast<std::size_t>(stream->sgetn(buffer.get() + end, std::min(available, room)));
+        return read_status::line;
+    }
+
+    template class basic_line_reader<char>;
+    template class basic_line_reader<wchar_t>;
+    template basic_line_reader<char>::basic_line_reader(int, std::size_t);
+
+    loop_result<char> input_loop(line_reader &reader, const check_spec &spec, const loop_options &options) {
+        return input_loop(reader, spec, [](std::string_view) {}, options);
+    }
+
+    bulk_result read_valid_lines(line_reader &reader, const check_spec &spec, const bulk_options &options) {
+        bulk_result result;
+        std::vector<std::string_view> lines;
+        std::string_view block;
+        while (true) {
+            switch (reader.next_block(block, options.timeout_ms)) {
+                case read_status::line:
+                    break;
+                case read_status::eof:
+                    result.status = loop_status::eof;
+                    return result;
+                case read_status::timeout:
+                    result.status = loop_status::timeout;
+                    return result;
+                case read_status::error:
+                    result.status = loop_status::error;
+                    return result;
+            }
+
+            lines.clear();
+            std::size_t pos = 0;
+            while (pos < block.size()) {
+                const void *found = std::memchr(block.data() + pos, '\n', block.size() - pos);
+                const std::size_t line_end = found ? static_cast<const char *>(found) - block.data() : block.size();
+                lines.push_back(strip_cr(block.substr(pos, line_end - pos)));
+                pos = line_end + 1;
+            }
+
+            const result_bitmap passed = check_batch(lines, spec, options.batch);
+            if (!options.batch.accepted) {
+                for (std::size_t i = 0; i < lines.size(); ++i) {
+                    if (passed[i]) result.values.emplace_back(lines[i]);
+                }
+            }
+            result.lines += lines.size();
+            result.rejected += lines.size() - passed.count();
+        }
+    }
+
+} // inpch
@@ -0,0 +1,161 @@
+#ifndef INPUTCHECK_INPUT_LOOP_H
+#define INPUTCHECK_INPUT_LOOP_H
+
+#include "batch_check.h"
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace inpch {
+
+    enum class read_status {
+        line,    // прочитана строка
+        eof,     // данные кончились (в том числе закрыт канал)
+        timeout, // новых данных не было дольше timeout_ms
+        error    // ошибка read или poll, см. basic_line_reader::error_code
+    };
+
+    // Построчное чтение через большой буфер из дескриптора или потока. Новые данные
+    // ожидаются в poll (для потока - в самом потоке), а не в цикле опроса.
+    // Строка возвращается без '\n' и без '\r' перед ним и действительна до следующего
+    // вызова next или next_block. Строка длиннее буфера увеличивает буфер.
+    //
+    // Читатель забирает данные из источника впрок: после него читать тот же
+    // дескриптор или поток напрямую нельзя.
+    template<class CharT>
+    class basic_line_reader {
+    public:
+        using view_type = std::basic_string_view<CharT>;
+
+        static constexpr std::size_t default_buffer = 1u << 16;
+
+        explicit basic_line_reader(std::basic_istream<CharT> &in, std::size_t buffer_size = default_buffer);
+
+        // Только для char: дескриптор POSIX, например 0 для stdin. Дескриптор не закрывается;
+        // неблокирующий дескриптор тоже годится
+        template<class C = CharT, class = std::enable_if_t<std::is_same<C, char>::value>>
+        explicit basic_line_reader(int fd, std::size_t buffer_size = default_buffer);
+
+        // timeout_ms - сколько ждать новых данных, < 0 - без ограничения. Ожидание
+        // с ограничением есть только у дескриптора: поток ждёт сам
+        read_status next(view_type &line, int timeout_ms = -1);
+
+        // Все целые строки, уже лежащие в буфере, одним куском (последняя - с '\n');
+        // если их нет, дочитывает. В конце данных - остаток без '\n'
+        read_status next_block(view_type &lines, int timeout_ms = -1);
+
+        // Номер последней строки, выданной next, начиная с 1
+        std::uint64_t line_number() const noexcept { return lines_read; }
+
+        // errno последней ошибки чтения
+        int error_code() const noexcept { return error; }
+
+    private:
+        std::unique_ptr<CharT[]> buffer;
+        std::size_t capacity;
+        std::size_t begin = 0;  // первый невыданный символ
+        std::size_t end = 0;    // конец прочитанных данных
+        std::size_t scanned = 0; // до сюда '\n' уже искался
+        std::basic_streambuf<CharT> *stream = nullptr;
+        int fd = -1;
+        bool finished = false;
+        int error = 0;
+        std::uint64_t lines_read = 0;
+
+        read_status fill(int timeout_ms);
+
+        read_status fill_fd(int timeout_ms);
+
+        read_status fill_stream();
+    };
+
+    using line_reader = basic_line_reader<char>;
+    using wline_reader = basic_line_reader<wchar_t>;
+
+    struct loop_options {
+        // Ожидание новых данных, мс; < 0 - без ограничения
+        int timeout_ms = -1;
+        // Сколько отклонённых строк терпеть; 0 - без ограничения
+        std::uint64_t max_rejects = 0;
+    };
+
+    enum class loop_status {
+        accepted,
+        eof,
+        timeout,
+        error,
+        too_many_rejects
+    };
+
+    template<class CharT>
+    struct loop_result {
+        loop_status status;
+        std::basic_string<CharT> value; // принятая строка, если status == accepted
+        std::uint64_t rejected = 0;
+    };
+
+    // Читает строки, пока accept(строка) не вернёт true; для каждой отклонённой
+    // вызывается on_reject(строка). В отличие от *_input_loop, не зацикливается на
+    // конце данных и ошибках, а сообщает о них в status
+    template<class CharT, class Accept, class Reject,
+             class = std::enable_if_t<std::is_invocable<Reject &, std::basic_string_view<CharT>>::value>>
+    loop_result<CharT> input_loop(basic_line_reader<CharT> &reader, Accept &&accept, Reject &&on_reject,
+                                  const loop_options &options = {}) {
+        loop_result<CharT> result{loop_status::eof, {}, 0};
+        std::basic_string_view<CharT> line;
+        while (true) {
+            switch (reader.next(line, options.timeout_ms)) {
+                case read_status::line:
+                    break;
+                case read_status::eof:
+                    result.status = loop_status::eof;
+                    return result;
+                case read_status::timeout:
+                    result.status = loop_status::timeout;
+                    return result;
+                case read_status::error:
+                    result.status = loop_status::error;
+                    return result;
+            }
+            if (accept(line)) {
+                result.status = loop_status::accepted;
+                result.value.assign(line);
+                return result;
+            }
+            on_reject(line);
+            if (++result.rejected == options.max_rejects) {
+                result.status = loop_status::too_many_rejects;
+                return result;
+            }
+        }
+    }
+
+    loop_result<char> input_loop(line_reader &reader, const check_spec &spec, const loop_options &options = {});
+
+    struct bulk_options {
+        // Ожидание новых данных, мс; < 0 - без ограничения
+        int timeout_ms = -1;
+        // Проверка строк каждого куска; большие куски проверяются в пуле.
+        // С batch.accepted принятые строки идут в string_pool, а values остаётся пустым
+        batch_options batch;
+    };
+
+    struct bulk_result {
+        loop_status status = loop_status::eof; // чем кончилось чтение: eof, timeout или error
+        std::vector<std::string> values;       // принятые строки в порядке следования
+        std::uint64_t lines = 0;
+        std::uint64_t rejected = 0;
+    };
+
+    // Пакетный режим: проверяет все строки до конца данных и возвращает принятые
+    // разом. Строки берутся кусками из буфера читателя и проверяются check_batch
+    bulk_result read_valid_lines(line_reader &reader, const check_spec &spec, const bulk_options &options = {});
+
+} // inpch
+
+#endif //INPUTCHECK_INPUT_LOOP_H
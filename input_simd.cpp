@@ -0,0 +1,1001 @@
+#include "input_simd.h"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define INPCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define INPCH_TARGET(isa_name)
+#else
+#include <cpuid.h>
+#define INPCH_TARGET(isa_name) __attribute__((target(isa_name)))
+#endif
+#endif
+
+namespace inpch::simd {
+
+    namespace {
+
+        // Байт x входит в k-й диапазон, если (x | fold[k]) лежит в [lo[k], hi[k]];
+        // fold = 0x20 сводит прописные латинские буквы к строчным
+        struct byte_ranges {
+            unsigned char lo[2];
+            unsigned char hi[2];
+            unsigned char fold[2];
+            int count;
+        };
+
+        constexpr byte_ranges ranges_of(byte_class cls) noexcept {
+            switch (cls) {
+                case byte_class::binary:
+                    return {{'0'}, {'1'}, {0}, 1};
+                case byte_class::octal:
+                    return {{'0'}, {'7'}, {0}, 1};
+                case byte_class::decimal:
+                    return {{'0'}, {'9'}, {0}, 1};
+                case byte_class::hexadecimal:
+                    return {{'0', 'a'}, {'9', 'f'}, {0, 0x20}, 2};
+                case byte_class::lower:
+                    return {{'a'}, {'z'}, {0}, 1};
+                case byte_class::upper:
+                    return {{'A'}, {'Z'}, {0}, 1};
+                case byte_class::alpha:
+                    return {{'a'}, {'z'}, {0x20}, 1};
+            }
+            return {{}, {}, {}, 0};
+        }
+
+        // Для каждого байта - битовая маска классов byte_class, в которые он входит
+        struct class_table {
+            unsigned char bits[256];
+
+            constexpr class_table() : bits() {
+                for (int cls = 0; cls <= static_cast<int>(byte_class::alpha); ++cls) {
+                    const byte_ranges r = ranges_of(static_cast<byte_class>(cls));
+                    for (int c = 0; c < 256; ++c) {
+                        for (int k = 0; k < r.count; ++k) {
+                            if ((c | r.fold[k]) >= r.lo[k] && (c | r.fold[k]) <= r.hi[k]) {
+                                bits[c] |= static_cast<unsigned char>(1u << cls);
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        constexpr class_table classes{};
+
+        std::size_t first_not_of_scalar(const char *data, std::size_t size, byte_class cls) noexcept {
+            const auto bit = static_cast<unsigned char>(1u << static_cast<int>(cls));
+            for (std::size_t i = 0; i < size; ++i) {
+                if (!(classes.bits[static_cast<unsigned char>(data[i])] & bit)) {
+                    return i;
+                }
+            }
+            return size;
+        }
+
+        // Кириллическая буква в UTF-8 занимает два байта (110xxxxx 10xxxxxx); класс -
+        // отрезок кодовых точек [lo, hi] и до двух отдельных точек (Ё, ё)
+        struct cyrillic_ranges {
+            std::uint16_t lo;
+            std::uint16_t hi;
+            std::uint16_t extra[2];
+        };
+
+        constexpr cyrillic_ranges ranges_of(cyrillic_class cls) noexcept {
+            switch (cls) {
+                case cyrillic_class::lower:
+                    return {0x0430, 0x044F, {0x0451, 0x0451}};
+                case cyrillic_class::upper:
+                    return {0x0410, 0x042F, {0x0401, 0x0401}};
+                case cyrillic_class::alpha:
+                    return {0x0410, 0x044F, {0x0401, 0x0451}};
+            }
+            return {1, 0, {0, 0}};
+        }
+
+        inline bool cyrillic_pair(unsigned char lead, unsigned char cont, const cyrillic_ranges &r) noexcept {
+            if ((lead & 0xE0) != 0xC0 || (cont & 0xC0) != 0x80) return false;
+            unsigned cp = ((lead & 0x1Fu) << 6) | (cont & 0x3Fu);
+            return (cp >= r.lo && cp <= r.hi) || cp == r.extra[0] || cp == r.extra[1];
+        }
+
+        std::size_t first_not_cyrillic_scalar(const char *data, std::size_t size, cyrillic_class cls) noexcept {
+            const cyrillic_ranges r = ranges_of(cls);
+            std::size_t i = 0;
+            for (; i + 2 <= size; i += 2) {
+                if (!cyrillic_pair(static_cast<unsigned char>(data[i]), static_cast<unsigned char>(data[i + 1]), r)) {
+                    return i;
+                }
+            }
+            return i;
+        }
+
+        // Широкие строки: кодовая единица u входит в k-й диапазон, если (u | fold[k])
+        // лежит в [lo[k], hi[k]]. Все классы укладываются в 0x0030-0x0451, поэтому
+        // единицы за пределами BMP и суррогаты не проходят никогда
+        struct unit_ranges {
+            std::uint16_t lo[3];
+            std::uint16_t hi[3];
+            std::uint16_t fold[3];
+            int count;
+        };
+
+        constexpr unit_ranges unit_ranges_of(byte_class cls) noexcept {
+            const byte_ranges r = ranges_of(cls);
+            unit_ranges out{{}, {}, {}, r.count};
+            for (int k = 0; k < r.count; ++k) {
+                out.lo[k] = r.lo[k];
+                out.hi[k] = r.hi[k];
+                out.fold[k] = r.fold[k];
+            }
+            return out;
+        }
+
+        // Кодовая точка в широкой строке хранится как есть: отрезок и отдельные Ё, ё
+        constexpr unit_ranges unit_ranges_of(cyrillic_class cls) noexcept {
+            const cyrillic_ranges r = ranges_of(cls);
+            if (r.extra[0] == r.extra[1]) {
+                return {{r.lo, r.extra[0]}, {r.hi, r.extra[0]}, {0, 0}, 2};
+            }
+            return {{r.lo, r.extra[0], r.extra[1]}, {r.hi, r.extra[0], r.extra[1]}, {0, 0, 0}, 3};
+        }
+
+        // Want = false ищет первую единицу вне класса, Want = true - первую в классе
+        template<bool Want, class Unit>
+        std::size_t find_unit_scalar(const Unit *data, std::size_t size, const unit_ranges &r) noexcept {
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto u = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<Unit>>(data[i]));
+                bool in = false;
+                for (int k = 0; k < r.count; ++k) {
+                    const std::uint32_t x = u | r.fold[k];
+                    in = in || (x >= r.lo[k] && x <= r.hi[k]);
+                }
+                if (in == Want) return i;
+            }
+            return size;
+        }
+
+        // Фильтр диапазона: те же сравнения, что в check_range. Упорядоченные сравнения
+        // ложны для NaN, поэтому без AcceptNan он не проходит ни inside, ни outside
+        template<bool Inside, bool AcceptNan, class T>
+        inline bool range_pass(T x, T left, T right) noexcept {
+            if constexpr (AcceptNan) {
+                if (x != x) return true;
+            }
+            if constexpr (Inside) {
+                return x >= left && x <= right;
+            } else {
+                return x < left || x > right;
+            }
+        }
+
+        template<bool Inside, bool AcceptNan, class T>
+        void range_mask_scalar(const T *values, std::size_t count, T left, T right, std::uint64_t *words) noexcept {
+            for (std::size_t w = 0; w * 64 < count; ++w) {
+                const std::size_t end = count - w * 64 < 64 ? count : w * 64 + 64;
+                std::uint64_t word = 0;
+                for (std::size_t i = w * 64; i < end; ++i) {
+                    word |= static_cast<std::uint64_t>(range_pass<Inside, AcceptNan>(values[i], left, right)) << (i % 64);
+                }
+                words[w] = word;
+            }
+        }
+
+        // Без ветвлений: номер пишется всегда, счётчик растёт только у прошедших
+        template<bool Inside, bool AcceptNan, class T>
+        std::size_t range_indices_scalar(const T *values, std::size_t count, T left, T right, std::uint32_t base,
+                                         std::uint32_t *out) noexcept {
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                out[n] = base + static_cast<std::uint32_t>(i);
+                n += range_pass<Inside, AcceptNan>(values[i], left, right);
+            }
+            return n;
+        }
+
+        // Для каждой 8-битной маски - номера её единичных битов по байту на номер
+        // и их число; по ним AVX2 собирает прошедшие номера одной перестановкой
+        struct compress_table {
+            std::uint64_t lanes[256];
+            std::uint8_t counts[256];
+
+            constexpr compress_table() : lanes(), counts() {
+                for (unsigned m = 0; m < 256; ++m) {
+                    unsigned pos = 0;
+                    for (unsigned b = 0; b < 8; ++b) {
+                        if (m & (1u << b)) lanes[m] |= static_cast<std::uint64_t>(b) << (8 * pos++);
+                    }
+                    counts[m] = static_cast<std::uint8_t>(pos);
+                }
+            }
+        };
+
+        constexpr compress_table compress{};
+
+#ifdef INPCH_X86
+
+        inline unsigned trailing_zeros(unsigned mask) noexcept {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        // Диапазон [lo, hi] сдвигается к -128, после чего проверка сводится
+        // к одному знаковому сравнению: x + (0x80 - lo) < -128 + (hi - lo + 1).
+        // Ядра вызываются только при size >= 16; хвост проверяется перекрывающейся
+        // загрузкой последнего блока, поэтому скалярный цикл в конце не нужен.
+        template<int N>
+        INPCH_TARGET("sse2")
+        inline unsigned block_mask_sse2(const char *at, const __m128i *fold, const __m128i *bias,
+                                        const __m128i *limit) noexcept {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            __m128i in = _mm_setzero_si128();
+            for (int k = 0; k < N; ++k) {
+                __m128i t = _mm_add_epi8(_mm_or_si128(x, fold[k]), bias[k]);
+                in = _mm_or_si128(in, _mm_cmplt_epi8(t, limit[k]));
+            }
+            return static_cast<unsigned>(_mm_movemask_epi8(in));
+        }
+
+        template<int N>
+        INPCH_TARGET("sse2")
+        std::size_t first_not_of_sse2(const char *data, std::size_t size, byte_class cls) noexcept {
+            const byte_ranges r = ranges_of(cls);
+            __m128i fold[N], bias[N], limit[N];
+            for (int k = 0; k < N; ++k) {
+                fold[k] = _mm_set1_epi8(static_cast<char>(r.fold[k]));
+                bias[k] = _mm_set1_epi8(static_cast<char>(0x80 - r.lo[k]));
+                limit[k] = _mm_set1_epi8(static_cast<char>(-128 + (r.hi[k] - r.lo[k]) + 1));
+            }
+
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                unsigned mask = block_mask_sse2<N>(data + i, fold, bias, limit);
+                if (mask != 0xFFFFu) return i + trailing_zeros(~mask);
+            }
+            if (i < size) {
+                i = size - 16;
+                unsigned mask = block_mask_sse2<N>(data + i, fold, bias, limit);
+                if (mask != 0xFFFFu) return i + trailing_zeros(~mask);
+            }
+            return size;
+        }
+
+        // 128-битный блок внутри AVX2-ядра: VEX-кодировка, без штрафа за смену SSE/AVX
+        template<int N>
+        INPCH_TARGET("avx2")
+        inline unsigned block_mask_vex128(const char *at, const __m256i *fold, const __m256i *bias,
+                                          const __m256i *limit) noexcept {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            __m128i in = _mm_setzero_si128();
+            for (int k = 0; k < N; ++k) {
+                __m128i t = _mm_add_epi8(_mm_or_si128(x, _mm256_castsi256_si128(fold[k])),
+                                         _mm256_castsi256_si128(bias[k]));
+                in = _mm_or_si128(in, _mm_cmplt_epi8(t, _mm256_castsi256_si128(limit[k])));
+            }
+            return static_cast<unsigned>(_mm_movemask_epi8(in));
+        }
+
+        template<int N>
+        INPCH_TARGET("avx2")
+        inline unsigned block_mask_avx2(const char *at, const __m256i *fold, const __m256i *bias,
+                                        const __m256i *limit) noexcept {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+            __m256i in = _mm256_setzero_si256();
+            for (int k = 0; k < N; ++k) {
+                __m256i t = _mm256_add_epi8(_mm256_or_si256(x, fold[k]), bias[k]);
+                in = _mm256_or_si256(in, _mm256_cmpgt_epi8(limit[k], t));
+            }
+            return static_cast<unsigned>(_mm256_movemask_epi8(in));
+        }
+
+        template<int N>
+        INPCH_TARGET("avx2")
+        std::size_t first_not_of_avx2(const char *data, std::size_t size, byte_class cls) noexcept {
+            const byte_ranges r = ranges_of(cls);
+            __m256i fold[N], bias[N], limit[N];
+            for (int k = 0; k < N; ++k) {
+                fold[k] = _mm256_set1_epi8(static_cast<char>(r.fold[k]));
+                bias[k] = _mm256_set1_epi8(static_cast<char>(0x80 - r.lo[k]));
+                limit[k] = _mm256_set1_epi8(static_cast<char>(-128 + (r.hi[k] - r.lo[k]) + 1));
+            }
+
+            if (size < 32) {
+                unsigned mask = block_mask_vex128<N>(data, fold, bias, limit);
+                if (mask != 0xFFFFu) return trailing_zeros(~mask);
+                mask = block_mask_vex128<N>(data + size - 16, fold, bias, limit);
+                if (mask != 0xFFFFu) return size - 16 + trailing_zeros(~mask);
+                return size;
+            }
+
+            std::size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                unsigned mask = block_mask_avx2<N>(data + i, fold, bias, limit);
+                if (mask != 0xFFFFFFFFu) return i + trailing_zeros(~mask);
+            }
+            if (i < size) {
+                i = size - 32;
+                unsigned mask = block_mask_avx2<N>(data + i, fold, bias, limit);
+                if (mask != 0xFFFFFFFFu) return i + trailing_zeros(~mask);
+            }
+            return size;
+        }
+
+        // Пары байтов обрабатываются как 16-битные слова (младший байт - ведущий):
+        // проверяются старшие биты обоих байтов, затем собранная кодовая точка
+        // сравнивается знаково - она меньше 0x800 и знаковый бит не задевает.
+        // Пары выровнены от начала строки, поэтому хвост берётся перекрывающейся
+        // загрузкой с чётного смещения, а нечётный последний байт всегда ошибка.
+        INPCH_TARGET("sse2")
+        inline unsigned cyrillic_mask_sse2(const char *at, const cyrillic_ranges &r) noexcept {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            __m128i shape = _mm_cmpeq_epi16(_mm_and_si128(x, _mm_set1_epi16(static_cast<short>(0xC0E0))),
+                                            _mm_set1_epi16(static_cast<short>(0x80C0)));
+            __m128i cp = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(x, _mm_set1_epi16(0x1F)), 6),
+                                      _mm_and_si128(_mm_srli_epi16(x, 8), _mm_set1_epi16(0x3F)));
+            __m128i in = _mm_and_si128(_mm_cmpgt_epi16(cp, _mm_set1_epi16(static_cast<short>(r.lo - 1))),
+                                       _mm_cmplt_epi16(cp, _mm_set1_epi16(static_cast<short>(r.hi + 1))));
+            in = _mm_or_si128(in, _mm_cmpeq_epi16(cp, _mm_set1_epi16(static_cast<short>(r.extra[0]))));
+            in = _mm_or_si128(in, _mm_cmpeq_epi16(cp, _mm_set1_epi16(static_cast<short>(r.extra[1]))));
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(in, shape)));
+        }
+
+        INPCH_TARGET("sse2")
+        std::size_t first_not_cyrillic_sse2(const char *data, std::size_t size, cyrillic_class cls) noexcept {
+            const cyrillic_ranges r = ranges_of(cls);
+            const std::size_t pairs = size & ~std::size_t{1};
+
+            std::size_t i = 0;
+            for (; i + 16 <= pairs; i += 16) {
+                unsigned mask = cyrillic_mask_sse2(data + i, r);
+                if (mask != 0xFFFFu) return i + trailing_zeros(~mask);
+            }
+            if (i < pairs) {
+                i = pairs - 16;
+                unsigned mask = cyrillic_mask_sse2(data + i, r);
+                if (mask != 0xFFFFu) return i + trailing_zeros(~mask);
+            }
+            return pairs;
+        }
+
+        INPCH_TARGET("avx2")
+        inline unsigned cyrillic_mask_vex128(const char *at, const cyrillic_ranges &r) noexcept {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            __m128i shape = _mm_cmpeq_epi16(_mm_and_si128(x, _mm_set1_epi16(static_cast<short>(0xC0E0))),
+                                            _mm_set1_epi16(static_cast<short>(0x80C0)));
+            __m128i cp = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(x, _mm_set1_epi16(0x1F)), 6),
+                                      _mm_and_si128(_mm_srli_epi16(x, 8), _mm_set1_epi16(0x3F)));
+            __m128i in = _mm_and_si128(_mm_cmpgt_epi16(cp, _mm_set1_epi16(static_cast<short>(r.lo - 1))),
+                                       _mm_cmpgt_epi16(_mm_set1_epi16(static_cast<short>(r.hi + 1)), cp));
+            in = _mm_or_si128(in, _mm_cmpeq_epi16(cp, _mm_set1_epi16(static_cast<short>(r.extra[0]))));
+            in = _mm_or_si128(in, _mm_cmpeq_epi16(cp, _mm_set1_epi16(static_cast<short>(r.extra[1]))));
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(in, shape)));
+        }
+
+        INPCH_TARGET("avx2")
+        inline unsigned cyrillic_mask_avx2(const char *at, const cyrillic_ranges &r) noexcept {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+            __m256i shape = _mm256_cmpeq_epi16(_mm256_and_si256(x, _mm256_set1_epi16(static_cast<short>(0xC0E0))),
+                                               _mm256_set1_epi16(static_cast<short>(0x80C0)));
+            __m256i cp = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(x, _mm256_set1_epi16(0x1F)), 6),
+                                         _mm256_and_si256(_mm256_srli_epi16(x, 8), _mm256_set1_epi16(0x3F)));
+            __m256i in = _mm256_and_si256(_mm256_cmpgt_epi16(cp, _mm256_set1_epi16(static_cast<short>(r.lo - 1))),
+                                          _mm256_cmpgt_epi16(_mm256_set1_epi16(static_cast<short>(r.hi + 1)), cp));
+            in = _mm256_or_si256(in, _mm256_cmpeq_epi16(cp, _mm256_set1_epi16(static_cast<short>(r.extra[0]))));
+            in = _mm256_or_si256(in, _mm256_cmpeq_epi16(cp, _mm256_set1_epi16(static_cast<short>(r.extra[1]))));
+            return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(in, shape)));
+        }
+
+        INPCH_TARGET("avx2")
+        std::size_t first_not_cyrillic_avx2(const char *data, std::size_t size, cyrillic_class cls) noexcept {
+            const cyrillic_ranges r = ranges_of(cls);
+            const std::size_t pairs = size & ~std::size_t{1};
+
+            if (pairs < 32) {
+                unsigned mask = cyrillic_mask_vex128(data, r);
+                if (mask != 0xFFFFu) return trailing_zeros(~mask);
+                mask = cyrillic_mask_vex128(data + pairs - 16, r);
+                if (mask != 0xFFFFu) return pairs - 16 + trailing_zeros(~mask);
+                return pairs;
+            }
+
+            std::size_t i = 0;
+            for (; i + 32 <= pairs; i += 32) {
+                unsigned mask = cyrillic_mask_avx2(data + i, r);
+                if (mask != 0xFFFFFFFFu) return i + trailing_zeros(~mask);
+            }
+            if (i < pairs) {
+                i = pairs - 32;
+                unsigned mask = cyrillic_mask_avx2(data + i, r);
+                if (mask != 0xFFFFFFFFu) return i + trailing_zeros(~mask);
+            }
+            return pairs;
+        }
+
+        // Широкие строки сводятся к 16-битным словам: 32-битные единицы сжимаются знаковым
+        // насыщением, которое переводит всё, что не помещается в 16 бит, в 0x7FFF или 0x8000 -
+        // вне любого класса. Дальше тот же сдвиг диапазона, что и для байтов, но в словах;
+        // каждое слово даёт два бита маски. Ядра вызываются при size >= 8 единиц,
+        // хвост - перекрывающейся загрузкой последнего блока.
+        template<int Width>
+        INPCH_TARGET("sse2")
+        inline __m128i load_units_sse2(const char *at) noexcept {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            if constexpr (Width == 4) {
+                x = _mm_packs_epi32(x, _mm_loadu_si128(reinterpret_cast<const __m128i *>(at + 16)));
+            }
+            return x;
+        }
+
+        template<int N>
+        INPCH_TARGET("sse2")
+        inline unsigned units_mask_sse2(__m128i x, const __m128i *fold, const __m128i *bias,
+                                        const __m128i *limit) noexcept {
+            __m128i in = _mm_setzero_si128();
+            for (int k = 0; k < N; ++k) {
+                __m128i t = _mm_add_epi16(_mm_or_si128(x, fold[k]), bias[k]);
+                in = _mm_or_si128(in, _mm_cmplt_epi16(t, limit[k]));
+            }
+            return static_cast<unsigned>(_mm_movemask_epi8(in));
+        }
+
+        template<int Width, int N, bool Want>
+        INPCH_TARGET("sse2")
+        std::size_t find_unit_sse2(const char *data, std::size_t size, const unit_ranges &r) noexcept {
+            __m128i fold[N], bias[N], limit[N];
+            for (int k = 0; k < N; ++k) {
+                fold[k] = _mm_set1_epi16(static_cast<short>(r.fold[k]));
+                bias[k] = _mm_set1_epi16(static_cast<short>(0x8000 - r.lo[k]));
+                limit[k] = _mm_set1_epi16(static_cast<short>(-32768 + (r.hi[k] - r.lo[k]) + 1));
+            }
+            // После xor единичные биты - у тех единиц, которые ищем
+            const unsigned flip = Want ? 0u : 0xFFFFu;
+
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                unsigned mask = units_mask_sse2<N>(load_units_sse2<Width>(data + i * Width), fold, bias, limit) ^ flip;
+                if (mask != 0) return i + trailing_zeros(mask) / 2;
+            }
+            if (i < size) {
+                i = size - 8;
+                unsigned mask = units_mask_sse2<N>(load_units_sse2<Width>(data + i * Width), fold, bias, limit) ^ flip;
+                if (mask != 0) return i + trailing_zeros(mask) / 2;
+            }
+            return size;
+        }
+
+        template<int Width>
+        INPCH_TARGET("avx2")
+        inline __m128i load_units_vex128(const char *at) noexcept {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            if constexpr (Width == 4) {
+                x = _mm_packs_epi32(x, _mm_loadu_si128(reinterpret_cast<const __m128i *>(at + 16)));
+            }
+            return x;
+        }
+
+        template<int Width>
+        INPCH_TARGET("avx2")
+        inline __m256i load_units_avx2(const char *at) noexcept {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+            if constexpr (Width == 4) {
+                // packs сжимает каждую 128-битную половину отдельно; перестановка
+                // четвертей возвращает единицы в исходный порядок
+                x = _mm256_packs_epi32(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at + 32)));
+                x = _mm256_permute4x64_epi64(x, 0xD8);
+            }
+            return x;
+        }
+
+        template<int N>
+        INPCH_TARGET("avx2")
+        inline unsigned units_mask_vex128(__m128i x, const __m256i *fold, const __m256i *bias,
+                                          const __m256i *limit) noexcept {
+            __m128i in = _mm_setzero_si128();
+            for (int k = 0; k < N; ++k) {
+                __m128i t = _mm_add_epi16(_mm_or_si128(x, _mm256_castsi256_si128(fold[k])),
+                                          _mm256_castsi256_si128(bias[k]));
+                in = _mm_or_si128(in, _mm_cmpgt_epi16(_mm256_castsi256_si128(limit[k]), t));
+            }
+            return static_cast<unsigned>(_mm_movemask_epi8(in));
+        }
+
+        template<int N>
+        INPCH_TARGET("avx2")
+        inline unsigned units_mask_avx2(__m256i x, const __m256i *fold, const __m256i *bias,
+                                        const __m256i *limit) noexcept {
+            __m256i in = _mm256_setzero_si256();
+            for (int k = 0; k < N; ++k) {
+                __m256i t = _mm256_add_epi16(_mm256_or_si256(x, fold[k]), bias[k]);
+                in = _mm256_or_si256(in, _mm256_cmpgt_epi16(limit[k], t));
+            }
+            return static_cast<unsigned>(_mm256_movemask_epi8(in));
+        }
+
+        template<int Width, int N, bool Want>
+        INPCH_TARGET("avx2")
+        std::size_t find_unit_avx2(const char *data, std::size_t size, const unit_ranges &r) noexcept {
+            __m256i fold[N], bias[N], limit[N];
+            for (int k = 0; k < N; ++k) {
+                fold[k] = _mm256_set1_epi16(static_cast<short>(r.fold[k]));
+                bias[k] = _mm256_set1_epi16(static_cast<short>(0x8000 - r.lo[k]));
+                limit[k] = _mm256_set1_epi16(static_cast<short>(-32768 + (r.hi[k] - r.lo[k]) + 1));
+            }
+
+            if (size < 16) {
+                const unsigned flip = Want ? 0u : 0xFFFFu;
+                unsigned mask = units_mask_vex128<N>(load_units_vex128<Width>(data), fold, bias, limit) ^ flip;
+                if (mask != 0) return trailing_zeros(mask) / 2;
+                const std::size_t last = size - 8;
+                mask = units_mask_vex128<N>(load_units_vex128<Width>(data + last * Width), fold, bias, limit) ^ flip;
+                if (mask != 0) return last + trailing_zeros(mask) / 2;
+                return size;
+            }
+
+            const unsigned flip = Want ? 0u : 0xFFFFFFFFu;
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                unsigned mask = units_mask_avx2<N>(load_units_avx2<Width>(data + i * Width), fold, bias, limit) ^ flip;
+                if (mask != 0) return i + trailing_zeros(mask) / 2;
+            }
+            if (i < size) {
+                i = size - 16;
+                unsigned mask = units_mask_avx2<N>(load_units_avx2<Width>(data + i * Width), fold, bias, limit) ^ flip;
+                if (mask != 0) return i + trailing_zeros(mask) / 2;
+            }
+            return size;
+        }
+
+        // Фильтр диапазона, AVX2: маска 8 элементов (64-битные - из двух векторов).
+        // Для целых inside - дополнение outside, для float и double сравнения
+        // упорядоченные, как в скалярном коде
+        template<bool Inside, bool AcceptNan, class T>
+        INPCH_TARGET("avx2")
+        inline unsigned range_bits_avx2(const T *at, T left, T right) noexcept {
+            if constexpr (std::is_same<T, float>::value) {
+                const __m256 x = _mm256_loadu_ps(at);
+                const __m256 l = _mm256_set1_ps(left), r = _mm256_set1_ps(right);
+                __m256 m;
+                if constexpr (Inside) {
+                    m = _mm256_and_ps(_mm256_cmp_ps(x, l, _CMP_GE_OQ), _mm256_cmp_ps(x, r, _CMP_LE_OQ));
+                } else {
+                    m = _mm256_or_ps(_mm256_cmp_ps(x, l, _CMP_LT_OQ), _mm256_cmp_ps(x, r, _CMP_GT_OQ));
+                }
+                if constexpr (AcceptNan) m = _mm256_or_ps(m, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+                return static_cast<unsigned>(_mm256_movemask_ps(m));
+            } else if constexpr (std::is_same<T, double>::value) {
+                const __m256d l = _mm256_set1_pd(left), r = _mm256_set1_pd(right);
+                unsigned bits = 0;
+                for (int half = 0; half < 2; ++half) {
+                    const __m256d x = _mm256_loadu_pd(at + 4 * half);
+                    __m256d m;
+                    if constexpr (Inside) {
+                        m = _mm256_and_pd(_mm256_cmp_pd(x, l, _CMP_GE_OQ), _mm256_cmp_pd(x, r, _CMP_LE_OQ));
+                    } else {
+                        m = _mm256_or_pd(_mm256_cmp_pd(x, l, _CMP_LT_OQ), _mm256_cmp_pd(x, r, _CMP_GT_OQ));
+                    }
+                    if constexpr (AcceptNan) m = _mm256_or_pd(m, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+                    bits |= static_cast<unsigned>(_mm256_movemask_pd(m)) << (4 * half);
+                }
+                return bits;
+            } else if constexpr (sizeof(T) == 4) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at));
+                const __m256i l = _mm256_set1_epi32(static_cast<int>(left));
+                const __m256i r = _mm256_set1_epi32(static_cast<int>(right));
+                const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(l, x), _mm256_cmpgt_epi32(x, r));
+                const auto bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+                return Inside ? ~bits & 0xFFu : bits;
+            } else {
+                const __m256i l = _mm256_set1_epi64x(static_cast<long long>(left));
+                const __m256i r = _mm256_set1_epi64x(static_cast<long long>(right));
+                unsigned bits = 0;
+                for (int half = 0; half < 2; ++half) {
+                    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(at + 4 * half));
+                    const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(l, x), _mm256_cmpgt_epi64(x, r));
+                    bits |= static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(outside))) << (4 * half);
+                }
+                return Inside ? ~bits & 0xFFu : bits;
+            }
+        }
+
+        template<bool Inside, bool AcceptNan, class T>
+        INPCH_TARGET("avx2")
+        void range_mask_avx2(const T *values, std::size_t count, T left, T right, std::uint64_t *words) noexcept {
+            std::size_t w = 0;
+            for (; (w + 1) * 64 <= count; ++w) {
+                std::uint64_t word = 0;
+                for (int k = 0; k < 8; ++k) {
+                    word |= static_cast<std::uint64_t>(
+                                    range_bits_avx2<Inside, AcceptNan>(values + w * 64 + 8 * k, left, right)) << (8 * k);
+                }
+                words[w] = word;
+            }
+            if (w * 64 < count) {
+                range_mask_scalar<Inside, AcceptNan>(values + w * 64, count - w * 64, left, right, words + w);
+            }
+        }
+
+        // Номера 8 элементов сжимаются перестановкой по compress_table; запись
+        // всех 8 дорожек безопасна, так как out + n + 8 <= out + i + 8 <= out + count
+        template<bool Inside, bool AcceptNan, class T>
+        INPCH_TARGET("avx2")
+        std::size_t range_indices_avx2(const T *values, std::size_t count, T left, T right, std::uint32_t base,
+                                       std::uint32_t *out) noexcept {
+            std::size_t n = 0, i = 0;
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(base)),
+                                             _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            const __m256i step = _mm256_set1_epi32(8);
+            for (; i + 8 <= count; i += 8) {
+                const unsigned bits = range_bits_avx2<Inside, AcceptNan>(values + i, left, right);
+                const __m256i order = _mm256_cvtepu8_epi32(
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&compress.lanes[bits])));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + n), _mm256_permutevar8x32_epi32(index, order));
+                n += compress.counts[bits];
+                index = _mm256_add_epi32(index, step);
+            }
+            return n + range_indices_scalar<Inside, AcceptNan>(values + i, count - i, left, right,
+                                                               base + static_cast<std::uint32_t>(i), out + n);
+        }
+
+        // AVX-512: маска 16 элементов прямо из сравнения в регистр opmask
+        template<bool Inside, bool AcceptNan, class T>
+        INPCH_TARGET("avx512f")
+        inline unsigned range_bits_avx512(const T *at, T left, T right) noexcept {
+            if constexpr (std::is_same<T, float>::value) {
+                const __m512 x = _mm512_loadu_ps(at);
+                const __m512 l = _mm512_set1_ps(left), r = _mm512_set1_ps(right);
+                __mmask16 m;
+                if constexpr (Inside) {
+                    m = _mm512_cmp_ps_mask(x, l, _CMP_GE_OQ) & _mm512_cmp_ps_mask(x, r, _CMP_LE_OQ);
+                } else {
+                    m = _mm512_cmp_ps_mask(x, l, _CMP_LT_OQ) | _mm512_cmp_ps_mask(x, r, _CMP_GT_OQ);
+                }
+                if constexpr (AcceptNan) m |= _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+                return m;
+            } else if constexpr (std::is_same<T, double>::value) {
+                const __m512d l = _mm512_set1_pd(left), r = _mm512_set1_pd(right);
+                unsigned bits = 0;
+                for (int half = 0; half < 2; ++half) {
+                    const __m512d x = _mm512_loadu_pd(at + 8 * half);
+                    __mmask8 m;
+                    if constexpr (Inside) {
+                        m = _mm512_cmp_pd_mask(x, l, _CMP_GE_OQ) & _mm512_cmp_pd_mask(x, r, _CMP_LE_OQ);
+                    } else {
+                        m = _mm512_cmp_pd_mask(x, l, _CMP_LT_OQ) | _mm512_cmp_pd_mask(x, r, _CMP_GT_OQ);
+                    }
+                    if constexpr (AcceptNan) m |= _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+                    bits |= static_cast<unsigned>(m) << (8 * half);
+                }
+                return bits;
+            } else if constexpr (sizeof(T) == 4) {
+                const __m512i x = _mm512_loadu_si512(at);
+                const __m512i l = _mm512_set1_epi32(static_cast<int>(left));
+                const __m512i r = _mm512_set1_epi32(static_cast<int>(right));
+                if constexpr (Inside) {
+                    return _mm512_cmp_epi32_mask(x, l, _MM_CMPINT_NLT) & _mm512_cmp_epi32_mask(x, r, _MM_CMPINT_LE);
+                } else {
+                    return _mm512_cmp_epi32_mask(x, l, _MM_CMPINT_LT) | _mm512_cmp_epi32_mask(x, r, _MM_CMPINT_NLE);
+                }
+            } else {
+                const __m512i l = _mm512_set1_epi64(static_cast<long long>(left));
+                const __m512i r = _mm512_set1_epi64(static_cast<long long>(right));
+                unsigned bits = 0;
+                for (int half = 0; half < 2; ++half) {
+                    const __m512i x = _mm512_loadu_si512(at + 8 * half);
+                    __mmask8 m;
+                    if constexpr (Inside) {
+                        m = _mm512_cmp_epi64_mask(x, l, _MM_CMPINT_NLT) & _mm512_cmp_epi64_mask(x, r, _MM_CMPINT_LE);
+                    } else {
+                        m = _mm512_cmp_epi64_mask(x, l, _MM_CMPINT_LT) | _mm512_cmp_epi64_mask(x, r, _MM_CMPINT_NLE);
+                    }
+                    bits |= static_cast<unsigned>(m) << (8 * half);
+                }
+                return bits;
+            }
+        }
+
+        template<bool Inside, bool AcceptNan, class T>
+        INPCH_TARGET("avx512f")
+        void range_mask_avx512(const T *values, std::size_t count, T left, T right, std::uint64_t *words) noexcept {
+            std::size_t w = 0;
+            for (; (w + 1) * 64 <= count; ++w) {
+                std::uint64_t word = 0;
+                for (int k = 0; k < 4; ++k) {
+                    word |= static_cast<std::uint64_t>(
+                                    range_bits_avx512<Inside, AcceptNan>(values + w * 64 + 16 * k, left, right)) << (16 * k);
+                }
+                words[w] = word;
+            }
+            if (w * 64 < count) {
+                range_mask_scalar<Inside, AcceptNan>(values + w * 64, count - w * 64, left, right, words + w);
+            }
+        }
+
+        // vpcompressd в регистр и полная запись: сжатие прямо в память на части
+        // процессоров микрокодовое и заметно медленнее
+        template<bool Inside, bool AcceptNan, class T>
+        INPCH_TARGET("avx512f")
+        std::size_t range_indices_avx512(const T *values, std::size_t count, T left, T right, std::uint32_t base,
+                                         std::uint32_t *out) noexcept {
+            std::size_t n = 0, i = 0;
+            __m512i index = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(base)),
+                                             _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+            const __m512i step = _mm512_set1_epi32(16);
+            for (; i + 16 <= count; i += 16) {
+                const unsigned bits = range_bits_avx512<Inside, AcceptNan>(values + i, left, right);
+                _mm512_storeu_si512(out + n, _mm512_maskz_compress_epi32(static_cast<__mmask16>(bits), index));
+                n += compress.counts[bits & 0xFFu] + compress.counts[bits >> 8];
+                index = _mm512_add_epi32(index, step);
+            }
+            return n + range_indices_scalar<Inside, AcceptNan>(values + i, count - i, left, right,
+                                                               base + static_cast<std::uint32_t>(i), out + n);
+        }
+
+        void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) noexcept {
+#if defined(_MSC_VER)
+            int out[4];
+            __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int k = 0; k < 4; ++k) regs[k] = static_cast<unsigned>(out[k]);
+#else
+            if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+                regs[0] = regs[1] = regs[2] = regs[3] = 0;
+            }
+#endif
+        }
+
+        unsigned long long xgetbv0() noexcept {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            unsigned eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+        }
+
+        isa probe_isa() noexcept {
+            unsigned regs[4];
+            cpuid(0, 0, regs);
+            unsigned max_leaf = regs[0];
+            if (max_leaf < 1) return isa::scalar;
+
+            cpuid(1, 0, regs);
+            bool sse2 = regs[3] & (1u << 26);
+            bool osxsave = regs[2] & (1u << 27);
+            bool avx = regs[2] & (1u << 28);
+            if (!sse2) return isa::scalar;
+
+            // AVX-регистры должны сохраняться ОС при переключении контекста
+            if (!(osxsave && avx) || (xgetbv0() & 0x6) != 0x6 || max_leaf < 7) return isa::sse2;
+
+            cpuid(7, 0, regs);
+            if (!(regs[1] & (1u << 5))) return isa::sse2;
+            // AVX-512F и сохранение ОС регистров opmask и верхних половин zmm
+            bool avx512 = (regs[1] & (1u << 16)) && (xgetbv0() & 0xE6) == 0xE6;
+            return avx512 ? isa::avx512 : isa::avx2;
+        }
+
+#else
+
+        isa probe_isa() noexcept {
+            return isa::scalar;
+        }
+
+#endif // INPCH_X86
+
+        std::atomic<isa> &active_level() noexcept {
+            static std::atomic<isa> level{detected_isa()};
+            return level;
+        }
+
+        template<int N>
+        std::size_t dispatch(const char *data, std::size_t size, byte_class cls) noexcept {
+            switch (active_level().load(std::memory_order_relaxed)) {
+#ifdef INPCH_X86
+                case isa::avx512:
+                case isa::avx2:
+                    return first_not_of_avx2<N>(data, size, cls);
+                case isa::sse2:
+                    return first_not_of_sse2<N>(data, size, cls);
+#endif
+                default:
+                    return first_not_of_scalar(data, size, cls);
+            }
+        }
+
+        template<bool Want, int N, class Unit>
+        std::size_t dispatch_units(const Unit *data, std::size_t size, const unit_ranges &r) noexcept {
+            switch (active_level().load(std::memory_order_relaxed)) {
+#ifdef INPCH_X86
+                case isa::avx512:
+                case isa::avx2:
+                    return find_unit_avx2<sizeof(Unit), N, Want>(reinterpret_cast<const char *>(data), size, r);
+                case isa::sse2:
+                    return find_unit_sse2<sizeof(Unit), N, Want>(reinterpret_cast<const char *>(data), size, r);
+#endif
+                default:
+                    return find_unit_scalar<Want>(data, size, r);
+            }
+        }
+
+        template<bool Want, class Unit>
+        std::size_t find_unit(const Unit *data, std::size_t size, const unit_ranges &r) noexcept {
+            static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4, "wide code units are 16 or 32 bits");
+            if (size < 8) {
+                return find_unit_scalar<Want>(data, size, r);
+            }
+            switch (r.count) {
+                case 1:
+                    return dispatch_units<Want, 1>(data, size, r);
+                case 2:
+                    return dispatch_units<Want, 2>(data, size, r);
+                default:
+                    return dispatch_units<Want, 3>(data, size, r);
+            }
+        }
+
+        // Выбор ядра по режиму: Inside и AcceptNan - параметры шаблона, чтобы
+        // во внутреннем цикле не было ветвлений
+        template<class T, class Call>
+        auto with_range_mode(bool inside, bool accept_nan, Call &&call) {
+            if constexpr (std::is_floating_point<T>::value) {
+                if (accept_nan) {
+                    return inside ? call(std::true_type{}, std::true_type{}) : call(std::false_type{}, std::true_type{});
+                }
+            } else {
+                (void) accept_nan;
+            }
+            return inside ? call(std::true_type{}, std::false_type{}) : call(std::false_type{}, std::false_type{});
+        }
+
+    } // namespace
+
+    std::size_t first_not_of(const char *data, std::size_t size, byte_class cls) noexcept {
+        // На коротких строках подготовка векторных констант дороже самой проверки
+        if (size < 16) {
+            return first_not_of_scalar(data, size, cls);
+        }
+        if (ranges_of(cls).count == 1) {
+            return dispatch<1>(data, size, cls);
+        }
+        return dispatch<2>(data, size, cls);
+    }
+
+    std::size_t first_not_cyrillic(const char *data, std::size_t size, cyrillic_class cls) noexcept {
+        if (size < 16) {
+            return first_not_cyrillic_scalar(data, size, cls);
+        }
+        switch (active_level().load(std::memory_order_relaxed)) {
+#ifdef INPCH_X86
+            case isa::avx512:
+            case isa::avx2:
+                return first_not_cyrillic_avx2(data, size, cls);
+            case isa::sse2:
+                return first_not_cyrillic_sse2(data, size, cls);
+#endif
+            default:
+                return first_not_cyrillic_scalar(data, size, cls);
+        }
+    }
+
+    template<class Unit>
+    std::size_t first_not_of(const Unit *data, std::size_t size, byte_class cls) noexcept {
+        return find_unit<false>(data, size, unit_ranges_of(cls));
+    }
+
+    template<class Unit>
+    std::size_t first_not_cyrillic(const Unit *data, std::size_t size, cyrillic_class cls) noexcept {
+        return find_unit<false>(data, size, unit_ranges_of(cls));
+    }
+
+    template<class Unit>
+    std::size_t first_of(const Unit *data, std::size_t size, byte_class cls) noexcept {
+        return find_unit<true>(data, size, unit_ranges_of(cls));
+    }
+
+    template<class Unit>
+    std::size_t first_cyrillic(const Unit *data, std::size_t size, cyrillic_class cls) noexcept {
+        return find_unit<true>(data, size, unit_ranges_of(cls));
+    }
+
+#define INPCH_WIDE_KERNELS(Unit) \
+    template std::size_t first_not_of<Unit>(const Unit *, std::size_t, byte_class) noexcept; \
+    template std::size_t first_not_cyrillic<Unit>(const Unit *, std::size_t, cyrillic_class) noexcept; \
+    template std::size_t first_of<Unit>(const Unit *, std::size_t, byte_class) noexcept; \
+    template std::size_t first_cyrillic<Unit>(const Unit *, std::size_t, cyrillic_class) noexcept;
+
+    INPCH_WIDE_KERNELS(wchar_t)
+    INPCH_WIDE_KERNELS(char16_t)
+    INPCH_WIDE_KERNELS(char32_t)
+
+#undef INPCH_WIDE_KERNELS
+
+    template<class T>
+    void range_mask(const T *values, std::size_t count, T left, T right, bool inside, bool accept_nan,
+                    std::uint64_t *words) noexcept {
+        const isa level = active_level().load(std::memory_order_relaxed);
+        with_range_mode<T>(inside, accept_nan, [&](auto in, auto nan) {
+            constexpr bool Inside = decltype(in)::value, AcceptNan = decltype(nan)::value;
+            switch (level) {
+#ifdef INPCH_X86
+                case isa::avx512:
+                    return range_mask_avx512<Inside, AcceptNan>(values, count, left, right, words);
+                case isa::avx2:
+                    return range_mask_avx2<Inside, AcceptNan>(values, count, left, right, words);
+#endif
+                default:
+                    return range_mask_scalar<Inside, AcceptNan>(values, count, left, right, words);
+            }
+        });
+    }
+
+    template<class T>
+    std::size_t range_indices(const T *values, std::size_t count, T left, T right, bool inside, bool accept_nan,
+                              std::uint32_t base, std::uint32_t *out) noexcept {
+        const isa level = active_level().load(std::memory_order_relaxed);
+        return with_range_mode<T>(inside, accept_nan, [&](auto in, auto nan) {
+            constexpr bool Inside = decltype(in)::value, AcceptNan = decltype(nan)::value;
+            switch (level) {
+#ifdef INPCH_X86
+                case isa::avx512:
+                    return range_indices_avx512<Inside, AcceptNan>(values, count, left, right, base, out);
+                case isa::avx2:
+                    return range_indices_avx2<Inside, AcceptNan>(values, count, left, right, base, out);
+#endif
+                default:
+                    return range_indices_scalar<Inside, AcceptNan>(values, count, left, right, base, out);
+            }
+        });
+    }
+
+#define INPCH_RANGE_KERNELS(T) \
+    template void range_mask<T>(const T *, std::size_t, T, T, bool, bool, std::uint64_t *) noexcept; \
+    template std::size_t range_indices<T>(const T *, std::size_t, T, T, bool, bool, std::uint32_t, \
+                                          std::uint32_t *) noexcept;
+
+    INPCH_RANGE_KERNELS(int)
+    INPCH_RANGE_KERNELS(long)
+    INPCH_RANGE_KERNELS(long long)
+    INPCH_RANGE_KERNELS(float)
+    INPCH_RANGE_KERNELS(double)
+
+#undef INPCH_RANGE_KERNELS
+
+    isa detected_isa() noexcept {
+        static const isa level = probe_isa();
+        return level;
+    }
+
+    isa active_isa() noexcept {
+        return active_level().load(std::memory_order_relaxed);
+    }
+
+    void set_isa(isa level) noexcept {
+        if (level > detected_isa()) level = detected_isa();
+        active_level().store(level, std::memory_order_relaxed);
+    }
+
+    const char *isa_name(isa level) noexcept {
+        switch (level) {
+            case isa::avx512:
+                return "avx512";
+            case isa::avx2:
+                return "avx2";
+            case isa::sse2:
+                return "sse2";
+            default:
+                return "scalar";
+        }
+    }
+
+} // inpch::simd
@@ -0,0 +1,114 @@
+#ifndef INPUTCHECK_INPUT_SIMD_H
+#define INPUTCHECK_INPUT_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace inpch::simd {
+
+    enum class isa {
+        scalar,
+        sse2,
+        avx2,
+        avx512 // AVX-512F; байтовым ядрам хватает AVX2, его используют фильтры диапазона
+    };
+
+    enum class byte_class {
+        binary,      // 0-1
+        octal,       // 0-7
+        decimal,     // 0-9
+        hexadecimal, // 0-9 a-f A-F
+        lower,       // a-z
+        upper,       // A-Z
+        alpha        // a-z A-Z
+    };
+
+    enum class cyrillic_class {
+        lower, // а-я ё
+        upper, // А-Я Ё
+        alpha  // а-я ё А-Я Ё
+    };
+
+    // Индекс первого байта, не попавшего в класс, либо size, если таких нет
+    std::size_t first_not_of(const char *data, std::size_t size, byte_class cls) noexcept;
+
+    inline bool all_of(const char *data, std::size_t size, byte_class cls) noexcept {
+        return first_not_of(data, size, cls) == size;
+    }
+
+    // Строка в UTF-8 из одних кириллических букв класса cls. Возвращает индекс первого
+    // байта символа, который не прошёл проверку (в том числе неверной или обрезанной
+    // последовательности UTF-8), либо size
+    std::size_t first_not_cyrillic(const char *data, std::size_t size, cyrillic_class cls) noexcept;
+
+    // Широкие строки: каждая кодовая единица (16 бит для char16_t и wchar_t в Windows,
+    // 32 бита для char32_t и wchar_t в Linux) проверяется целиком, без усечения до байта;
+    // суррогатные пары и символы за пределами классов не проходят.
+    // Определены для Unit = wchar_t, char16_t, char32_t.
+    template<class Unit>
+    std::size_t first_not_of(const Unit *data, std::size_t size, byte_class cls) noexcept;
+
+    template<class Unit>
+    std::size_t first_not_cyrillic(const Unit *data, std::size_t size, cyrillic_class cls) noexcept;
+
+    // Индекс первой кодовой единицы, попавшей в класс, либо size
+    template<class Unit>
+    std::size_t first_of(const Unit *data, std::size_t size, byte_class cls) noexcept;
+
+    template<class Unit>
+    std::size_t first_cyrillic(const Unit *data, std::size_t size, cyrillic_class cls) noexcept;
+
+    template<class Unit>
+    bool all_of(const Unit *data, std::size_t size, byte_class cls) noexcept {
+        return first_not_of(data, size, cls) == size;
+    }
+
+    // Фильтр диапазона для массивов чисел, T = int, long, long long, float, double.
+    // Элемент проходит, как в check_range: при inside - left <= x <= right, иначе
+    // x < left || x > right; NaN проходит только при accept_nan.
+    // words получает (count + 63) / 64 слов, бит i - элемент i
+    template<class T>
+    void range_mask(const T *values, std::size_t count, T left, T right, bool inside, bool accept_nan,
+                    std::uint64_t *words) noexcept;
+
+    // Номера base + i прошедших элементов по возрастанию; возвращает их число.
+    // В out должно быть место на count номеров
+    template<class T>
+    std::size_t range_indices(const T *values, std::size_t count, T left, T right, bool inside, bool accept_nan,
+                              std::uint32_t base, std::uint32_t *out) noexcept;
+
+    // Скалярная проверка одного символа (в том числе широкого) на принадлежность классу
+    constexpr bool in_class(char32_t ch, byte_class cls) noexcept {
+        switch (cls) {
+            case byte_class::binary:
+                return ch == U'0' || ch == U'1';
+            case byte_class::octal:
+                return ch >= U'0' && ch <= U'7';
+            case byte_class::decimal:
+                return ch >= U'0' && ch <= U'9';
+            case byte_class::hexadecimal:
+                return (ch >= U'0' && ch <= U'9') || (ch >= U'a' && ch <= U'f') || (ch >= U'A' && ch <= U'F');
+            case byte_class::lower:
+                return ch >= U'a' && ch <= U'z';
+            case byte_class::upper:
+                return ch >= U'A' && ch <= U'Z';
+            case byte_class::alpha:
+                return (ch >= U'a' && ch <= U'z') || (ch >= U'A' && ch <= U'Z');
+        }
+        return false;
+    }
+
+    // Лучший набор инструкций, доступный процессору (по CPUID)
+    isa detected_isa() noexcept;
+
+    // Набор инструкций, используемый ядрами сейчас
+    isa active_isa() noexcept;
+
+    // Ограничивает используемый набор инструкций; выше detected_isa() подняться нельзя
+    void set_isa(isa level) noexcept;
+
+    const char *isa_name(isa level) noexcept;
+
+} // inpch::simd
+
+#endif //INPUTCHECK_INPUT_SIMD_H
@@ -0,0 +1,235 @@
+#include "instrumentation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace inpch::stats {
+
+    namespace {
+
+        struct registry {
+            std::mutex mutex;
+            std::vector<thread_block *> blocks;
+            // Счётчики завершившихся потоков
+            check_counters retired[check_count]{};
+        };
+
+        // Не разрушается: потоки могут завершаться и после статических деструкторов
+        registry &blocks_registry() {
+            static registry *instance = new registry;
+            return *instance;
+        }
+
+        void add(check_counters &to, const thread_block::counters &from) noexcept {
+            for (std::size_t r = 0; r < reason_count; ++r) {
+                std::uint64_t n = from.outcomes[r].load(std::memory_order_relaxed);
+                to.calls += n;
+                if (r == static_cast<std::size_t>(check_error::none)) {
+                    to.accepted += n;
+                } else {
+                    to.rejected[r] += n;
+                }
+            }
+            to.bytes += from.bytes.load(std::memory_order_relaxed);
+            for (std::size_t b = 0; b < latency_buckets; ++b) {
+                std::uint64_t n = from.latency[b].load(std::memory_order_relaxed);
+                to.latency[b] += n;
+                to.latency_samples += n;
+            }
+        }
+
+        void clear(thread_block &block) noexcept {
+            for (auto &c: block.checks) {
+                for (auto &n: c.outcomes) n.store(0, std::memory_order_relaxed);
+                c.bytes.store(0, std::memory_order_relaxed);
+                for (auto &n: c.latency) n.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        struct thread_owner {
+            thread_block block;
+
+            thread_owner() {
+                clear(block);
+                registry &r = blocks_registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.blocks.push_back(&block);
+            }
+
+            ~thread_owner() {
+                registry &r = blocks_registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                for (std::size_t i = 0; i < check_count; ++i) add(r.retired[i], block.checks[i]);
+                for (auto it = r.blocks.begin(); it != r.blocks.end(); ++it) {
+                    if (*it == &block) {
+                        r.blocks.erase(it);
+                        break;
+                    }
+                }
+                current_block = nullptr;
+            }
+        };
+
+        std::uint64_t now_ns() noexcept {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        template<class... Args>
+        void append(std::string &out, const char *format, Args... args) {
+            char buffer[256];
+            int written = std::snprintf(buffer, sizeof(buffer), format, args...);
+            if (written <= 0) return;
+            out.append(buffer, std::min(static_cast<std::size_t>(written), sizeof(buffer) - 1));
+        }
+
+    } // namespace
+
+    thread_block &attach_thread() noexcept {
+        thread_local thread_owner owner;
+        current_block = &owner.block;
+        return owner.block;
+    }
+
+    std::uint64_t sample_start() noexcept {
+        return now_ns();
+    }
+
+    void sample_stop(thread_block::counters &counters, std::uint64_t start) noexcept {
+        std::uint64_t ns = now_ns() - start;
+        std::size_t bucket = 0;
+        while (bucket + 1 < latency_buckets && (ns >> (bucket + 1)) != 0) ++bucket;
+        bump(counters.latency[bucket]);
+    }
+
+    std::uint64_t check_counters::latency_quantile_ns(double q) const noexcept {
+        if (latency_samples == 0) return 0;
+        auto target = static_cast<std::uint64_t>(q * static_cast<double>(latency_samples));
+        if (target >= latency_samples) target = latency_samples - 1;
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < latency_buckets; ++b) {
+            seen += latency[b];
+            if (seen > target) return std::uint64_t{1} << (b + 1);
+        }
+        return std::uint64_t{1} << latency_buckets;
+    }
+
+    snapshot collect() {
+        snapshot result{};
+#ifdef INPCH_INSTRUMENTATION
+        result.sample_period = INPCH_INSTRUMENTATION_SAMPLE;
+#endif
+        registry &r = blocks_registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (std::size_t i = 0; i < check_count; ++i) {
+            result.checks[i] = r.retired[i];
+            for (thread_block *block: r.blocks) add(result.checks[i], block->checks[i]);
+        }
+        return result;
+    }
+
+    void reset() {
+        registry &r = blocks_registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto &c: r.retired) c = check_counters{};
+        for (thread_block *block: r.blocks) clear(*block);
+    }
+
+    const char *check_name(check_id id) noexcept {
+        switch (id) {
+            case check_id::is_decimal:
+                return "is_decimal";
+            case check_id::is_hexadecimal:
+                return "is_hexadecimal";
+            case check_id::is_octal:
+                return "is_octal";
+            case check_id::is_binary:
+                return "is_binary";
+            case check_id::input_check_base:
+                return "input_check_base";
+            case check_id::input_check_language:
+                return "input_check_language";
+            case check_id::input_check_range:
+                return "input_check_range";
+            case check_id::content_type_of:
+                return "content_type_of";
+            case check_id::input_match_regex:
+                return "input_match_regex";
+            case check_id::input_match_dfa:
+                return "input_match_dfa";
+            default:
+                return "unknown";
+        }
+    }
+
+    const char *reason_name(check_error reason) noexcept {
+        switch (reason) {
+            case check_error::none:
+                return "none";
+            case check_error::empty_input:
+                return "empty_input";
+            case check_error::wrong_length:
+                return "wrong_length";
+            case check_error::wrong_character:
+                return "wrong_character";
+            case check_error::out_of_range:
+                return "out_of_range";
+            case check_error::no_match:
+                return "no_match";
+            case check_error::wrong_base:
+                return "wrong_base";
+            case check_error::wrong_language:
+                return "wrong_language";
+            case check_error::wrong_type:
+                return "wrong_type";
+        }
+        return "unknown";
+    }
+
+    std::string snapshot::to_text() const {
+        std::string out;
+        append(out, "%-22s %12s %12s %12s %14s %9s %9s  %s\n",
+               "check", "calls", "accepted", "rejected", "bytes", "p50<=ns", "p99<=ns", "reject reasons");
+        for (std::size_t i = 0; i < check_count; ++i) {
+            const check_counters &c = checks[i];
+            if (c.calls == 0) continue;
+            append(out, "%-22s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %9" PRIu64 " %9" PRIu64 " ",
+                   check_name(static_cast<check_id>(i)), c.calls, c.accepted, c.calls - c.accepted, c.bytes,
+                   c.latency_quantile_ns(0.5), c.latency_quantile_ns(0.99));
+            for (std::size_t r = 1; r < reason_count; ++r) {
+                if (c.rejected[r]) append(out, " %s=%" PRIu64, reason_name(static_cast<check_error>(r)), c.rejected[r]);
+            }
+            out += '\n';
+        }
+        return out;
+    }
+
+    std::string snapshot::to_json() const {
+        std::string out;
+        append(out, "{\"sample_period\": %" PRIu64 ", \"checks\": [", sample_period);
+        for (std::size_t i = 0; i < check_count; ++i) {
+            const check_counters &c = checks[i];
+            append(out, "%s\n  {\"name\": \"%s\", \"calls\": %" PRIu64 ", \"accepted\": %" PRIu64
+                        ", \"bytes\": %" PRIu64 ", \"rejected\": {",
+                   i ? "," : "", check_name(static_cast<check_id>(i)), c.calls, c.accepted, c.bytes);
+            for (std::size_t r = 1; r < reason_count; ++r) {
+                append(out, "%s\"%s\": %" PRIu64, r > 1 ? ", " : "", reason_name(static_cast<check_error>(r)),
+                       c.rejected[r]);
+            }
+            append(out, "}, \"latency_samples\": %" PRIu64 ", \"latency_p50_ns\": %" PRIu64
+                        ", \"latency_p99_ns\": %" PRIu64 ", \"latency_histogram\": [",
+                   c.latency_samples, c.latency_quantile_ns(0.5), c.latency_quantile_ns(0.99));
+            for (std::size_t b = 0; b < latency_buckets; ++b) {
+                append(out, "%s%" PRIu64, b ? ", " : "", c.latency[b]);
+            }
+            out += "]}";
+        }
+        out += "\n]}\n";
+        return out;
+    }
+
+} // inpch::stats
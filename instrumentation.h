@@ -0,0 +1,158 @@
+#ifndef INPUTCHECK_INSTRUMENTATION_H
+#define INPUTCHECK_INSTRUMENTATION_H
+
+#include "check_result.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Счётчики включаются определением INPCH_INSTRUMENTATION (опция CMake с тем же
+// именем). Без него measure() сводится к вызову проверки и ничего не стоит.
+// INPCH_INSTRUMENTATION_SAMPLE - время измеряется у каждого N-го вызова в потоке
+// (степень двойки).
+#ifndef INPCH_INSTRUMENTATION_SAMPLE
+#define INPCH_INSTRUMENTATION_SAMPLE 64
+#endif
+
+namespace inpch::stats {
+
+    static_assert((INPCH_INSTRUMENTATION_SAMPLE & (INPCH_INSTRUMENTATION_SAMPLE - 1)) == 0,
+                  "INPCH_INSTRUMENTATION_SAMPLE must be a power of two");
+
+    enum class check_id : std::uint8_t {
+        is_decimal,
+        is_hexadecimal,
+        is_octal,
+        is_binary,
+        input_check_base,
+        input_check_language,
+        input_check_range,
+        content_type_of,
+        input_match_regex,
+        input_match_dfa,
+        count
+    };
+
+    inline constexpr std::size_t check_count = static_cast<std::size_t>(check_id::count);
+    inline constexpr std::size_t reason_count = static_cast<std::size_t>(check_error::wrong_type) + 1;
+    // Корзина k - время вызова в [2^k, 2^(k+1)) нс, последняя - всё, что дольше
+    inline constexpr std::size_t latency_buckets = 32;
+
+    struct check_counters {
+        std::uint64_t calls;
+        std::uint64_t accepted;
+        std::uint64_t rejected[reason_count]; // по check_error; rejected[none] не используется
+        std::uint64_t bytes;
+        std::uint64_t latency_samples;
+        std::uint64_t latency[latency_buckets];
+
+        // Верхняя граница корзины, в которую попадает доля q измеренных вызовов
+        std::uint64_t latency_quantile_ns(double q) const noexcept;
+    };
+
+    struct snapshot {
+        check_counters checks[check_count];
+        std::uint64_t sample_period;
+
+        const check_counters &operator[](check_id id) const noexcept {
+            return checks[static_cast<std::size_t>(id)];
+        }
+
+        std::string to_text() const;
+
+        std::string to_json() const;
+    };
+
+    // Сумма счётчиков всех потоков, включая завершившиеся
+    snapshot collect();
+
+    // Обнуляет счётчики; вызовы, идущие одновременно с reset, могут частично уцелеть
+    void reset();
+
+    const char *check_name(check_id id) noexcept;
+
+    const char *reason_name(check_error reason) noexcept;
+
+    /* -------------------------------- Declarations -------------------------------- */
+
+    // Счётчики потока. Пишет их только владелец (load + store без блокировок),
+    // collect() читает их из других потоков
+    struct thread_block {
+        struct counters {
+            std::atomic<std::uint64_t> outcomes[reason_count]; // outcomes[none] - принятые
+            std::atomic<std::uint64_t> bytes;
+            std::atomic<std::uint64_t> latency[latency_buckets];
+        };
+
+        counters checks[check_count];
+        std::uint32_t calls = 0;
+    };
+
+    inline thread_local thread_block *current_block = nullptr;
+
+    // Регистрирует счётчики текущего потока
+    thread_block &attach_thread() noexcept;
+
+    inline void bump(std::atomic<std::uint64_t> &counter, std::uint64_t by = 1) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    inline check_error outcome_of(bool accepted, check_error reason) noexcept {
+        return accepted ? check_error::none : reason;
+    }
+
+    inline check_error outcome_of(const check_result &result, check_error) noexcept {
+        return result.error;
+    }
+
+    // Проверки без признака отказа (content_type_of) считаются принятыми
+    template<class R>
+    check_error outcome_of(const R &, check_error) noexcept {
+        return check_error::none;
+    }
+
+    template<class T>
+    std::size_t bytes_of(const T &input) noexcept {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return sizeof(T);
+        } else {
+            return input.size() * sizeof(typename T::value_type);
+        }
+    }
+
+    // Замер времени вынесен из measure(), чтобы горячий путь оставался коротким
+    // и встраивался в место вызова
+    std::uint64_t sample_start() noexcept;
+
+    void sample_stop(thread_block::counters &counters, std::uint64_t start) noexcept;
+
+    // Выполняет check() и записывает исход: булев false учитывается как reason
+    template<class F>
+    auto measure(check_id id, std::size_t bytes, check_error reason, F &&check) noexcept(noexcept(check())) {
+#ifdef INPCH_INSTRUMENTATION
+        thread_block *block = current_block;
+        if (!block) block = &attach_thread();
+        thread_block::counters &c = block->checks[static_cast<std::size_t>(id)];
+
+        // Время измеряется у каждого sample-го вызова потока; счётчик вызовов потока
+        // заодно служит для выбора вызова
+        const bool timed = (++block->calls & (INPCH_INSTRUMENTATION_SAMPLE - 1)) == 0;
+        const std::uint64_t start = timed ? sample_start() : 0;
+        auto outcome = check();
+        bump(c.outcomes[static_cast<std::size_t>(outcome_of(outcome, reason))]);
+        bump(c.bytes, bytes);
+        if (timed) sample_stop(c, start);
+        return outcome;
+#else
+        (void) id;
+        (void) bytes;
+        (void) reason;
+        return check();
+#endif
+    }
+
+} // inpch::stats
+
+#endif //INPUTCHECK_INSTRUMENTATION_H
@@ -0,0 +1,178 @@
+#ifndef INPUTCHECK_NUMBER_PARSE_H
+#define INPUTCHECK_NUMBER_PARSE_H
+
+#include "input_check.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace inpch {
+
+    enum class parse_error {
+        none,
+        empty,
+        invalid_character,
+        overflow,
+        out_of_range
+    };
+
+    template<class Int>
+    struct parse_result {
+        Int value;
+        parse_error error;
+        // Индекс первого недопустимого символа; при переполнении - цифры, на которой
+        // значение вышло за пределы типа; при out_of_range и успехе - размер строки
+        std::size_t position;
+
+        explicit operator bool() const noexcept { return error == parse_error::none; }
+    };
+
+    // Проверка и преобразование за один проход. Допустимые строки те же, что
+    // у is_decimal/is_octal/is_hexadecimal/is_binary: знак только у decimal,
+    // без префиксов 0x/0b. Отрицательное число для беззнакового типа - overflow.
+    template<class Int>
+    parse_result<Int> parse_number(std::string_view input, const base_type &base = decimal) noexcept;
+
+    // То же с проверкой диапазона как у числового конструктора input_check:
+    // inside - значение в [left, right], иначе - вне его
+    template<class Int>
+    parse_result<Int> parse_number(std::string_view input, const base_type &base,
+                                   const Int &left, const Int &right, bool inside = true) noexcept;
+
+    /* -------------------------------- Declarations -------------------------------- */
+
+    namespace parse_detail {
+
+        struct digit_table {
+            unsigned char value[256];
+
+            constexpr digit_table() : value() {
+                for (int c = 0; c < 256; ++c) value[c] = 0xFF;
+                for (int c = '0'; c <= '9'; ++c) value[c] = static_cast<unsigned char>(c - '0');
+                for (int c = 'a'; c <= 'f'; ++c) value[c] = static_cast<unsigned char>(c - 'a' + 10);
+                for (int c = 'A'; c <= 'F'; ++c) value[c] = static_cast<unsigned char>(c - 'A' + 10);
+            }
+        };
+
+        inline constexpr digit_table digits{};
+
+        inline simd::byte_class class_of(const base_type &base) noexcept {
+            switch (base) {
+                case binary:
+                    return simd::byte_class::binary;
+                case octal:
+                    return simd::byte_class::octal;
+                case hexadecimal:
+                    return simd::byte_class::hexadecimal;
+                default:
+                    return simd::byte_class::decimal;
+            }
+        }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        inline bool eight_digits(const char *, std::uint32_t &) noexcept { return false; }
+#else
+
+        // Проверяет и переводит 8 десятичных цифр одним 64-битным словом (SWAR)
+        inline bool eight_digits(const char *p, std::uint32_t &out) noexcept {
+            std::uint64_t x;
+            std::memcpy(&x, p, sizeof(x));
+            if ((((x & 0xF0F0F0F0F0F0F0F0ull) | (((x + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))) !=
+                0x3333333333333333ull) {
+                return false;
+            }
+            x = (x & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+            x = (x & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+            out = static_cast<std::uint32_t>((x & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32);
+            return true;
+        }
+
+#endif
+
+        // Переполнение найдено на позиции at; если дальше есть недопустимый символ,
+        // сообщается о нём, а не о переполнении
+        template<class Int>
+        parse_result<Int> overflow_at(std::string_view input, std::size_t at, const base_type &base) noexcept {
+            std::size_t bad = at + simd::first_not_of(input.data() + at, input.size() - at, class_of(base));
+            if (bad != input.size()) return {Int{}, parse_error::invalid_character, bad};
+            return {Int{}, parse_error::overflow, at};
+        }
+
+    } // namespace parse_detail
+
+    template<class Int>
+    parse_result<Int> parse_number(std::string_view input, const base_type &base) noexcept {
+        static_assert(std::is_integral<Int>::value && !std::is_same<Int, bool>::value,
+                      "parse_number requires an integer type");
+        using U = std::make_unsigned_t<Int>;
+        using namespace parse_detail;
+
+        if (input.empty()) return {Int{}, parse_error::empty, 0};
+
+        std::size_t i = 0;
+        bool negative = false;
+        if (base == decimal && (input[0] == '+' || input[0] == '-')) {
+            negative = input[0] == '-';
+            i = 1;
+            if (input.size() == 1) return {Int{}, parse_error::invalid_character, 1};
+        }
+
+        unsigned radix;
+        switch (base) {
+            case decimal:
+            case octal:
+            case hexadecimal:
+            case binary:
+                radix = static_cast<unsigned>(base);
+                break;
+            default:
+                return {Int{}, parse_error::invalid_character, 0};
+        }
+
+        // Модуль отрицательного числа может быть на единицу больше максимума
+        U limit = static_cast<U>(std::numeric_limits<Int>::max());
+        if (negative && std::is_signed<Int>::value) limit = static_cast<U>(limit + 1);
+        if (negative && std::is_unsigned<Int>::value) limit = 0;
+
+        U acc = 0;
+        if (radix == 10 && limit != 0) {
+            // Ведущие нули не влияют на значение; пока значащих цифр не больше digits10,
+            // переполнение невозможно и проверять его не нужно
+            while (i < input.size() && input[i] == '0') ++i;
+            std::size_t significant = 0;
+            std::uint32_t block;
+            while (i + 8 <= input.size() && significant + 8 <= std::numeric_limits<Int>::digits10 &&
+                   eight_digits(input.data() + i, block)) {
+                acc = static_cast<U>(acc * 100000000u + block);
+                significant += 8;
+                i += 8;
+            }
+        }
+
+        for (; i < input.size(); ++i) {
+            unsigned d = digits.value[static_cast<unsigned char>(input[i])];
+            if (d >= radix) return {Int{}, parse_error::invalid_character, i};
+            if (d > limit || acc > (limit - d) / radix) return overflow_at<Int>(input, i, base);
+            acc = static_cast<U>(acc * radix + d);
+        }
+
+        Int value = negative ? static_cast<Int>(U(0) - acc) : static_cast<Int>(acc);
+        return {value, parse_error::none, input.size()};
+    }
+
+    template<class Int>
+    parse_result<Int> parse_number(std::string_view input, const base_type &base,
+                                   const Int &left, const Int &right, bool inside) noexcept {
+        parse_result<Int> result = parse_number<Int>(input, base);
+        if (result.error != parse_error::none) return result;
+        bool within = result.value >= left && result.value <= right;
+        if (within != inside) result.error = parse_error::out_of_range;
+        return result;
+    }
+
+} // inpch
+
+#endif //INPUTCHECK_NUMBER_PARSE_H
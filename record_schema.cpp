@@ -0,0 +1,218 @@
+#include "record_schema.h"
+#include "number_parse.h"
+
+#include <stdexcept>
+
+namespace inpch {
+
+    field_rule &field_rule::length(int length) noexcept {
+        expected_length = length;
+        return *this;
+    }
+
+    field_rule &field_rule::base(const base_type &base) noexcept {
+        number_base = base;
+        return *this;
+    }
+
+    field_rule &field_rule::lang(const language &lang) noexcept {
+        has_language = true;
+        text_language = lang;
+        return *this;
+    }
+
+    field_rule &field_rule::range(long long left, long long right, bool inside) noexcept {
+        has_range = true;
+        range_left = left;
+        range_right = right;
+        range_inside = inside;
+        return *this;
+    }
+
+    field_rule &field_rule::match(const dfa_pattern &pattern) {
+        automaton = &pattern.get();
+        return *this;
+    }
+
+    field_rule &field_rule::match(const std::regex &regex) noexcept {
+        this->regex = &regex;
+        return *this;
+    }
+
+    field_rule &field_rule::date(date_format format) noexcept {
+        has_date = true;
+        dates = format;
+        return *this;
+    }
+
+    field_rule &field_rule::optional() noexcept {
+        may_be_empty = true;
+        return *this;
+    }
+
+    namespace {
+
+        simd::byte_class class_of_base(const base_type &base) {
+            switch (base) {
+                case decimal:
+                    return simd::byte_class::decimal;
+                case octal:
+                    return simd::byte_class::octal;
+                case hexadecimal:
+                    return simd::byte_class::hexadecimal;
+                case binary:
+                    return simd::byte_class::binary;
+                default:
+                    throw WrongBaseException();
+            }
+        }
+
+        constexpr field_mask bit(std::size_t field) noexcept { return field_mask{1} << field; }
+
+    } // namespace
+
+    record_schema::record_schema(const std::vector<field_rule> &rules)
+            : fields(rules.size()) {
+        if (rules.size() > max_fields) throw std::length_error("record_schema");
+        all = fields == max_fields ? ~field_mask{0} : bit(fields) - 1;
+
+        for (std::uint32_t i = 0; i < rules.size(); ++i) {
+            const field_rule &rule = rules[i];
+            if (rule.may_be_empty) optional_fields |= bit(i);
+            if (rule.expected_length != any_length) {
+                lengths.push_back({i, rule.expected_length < 0 ? 0 : static_cast<std::size_t>(rule.expected_length)});
+            }
+
+            // Разбор числа уже проверяет цифры, отдельная проверка системы не нужна
+            if (rule.has_range) {
+                base_type base = rule.number_base == not_a_number ? decimal : rule.number_base;
+                class_of_base(base); // бросает WrongBaseException при неверной системе
+                ranges.push_back({i, base, rule.range_left, rule.range_right, rule.range_inside});
+            } else if (rule.number_base != not_a_number) {
+                simd::byte_class cls = class_of_base(rule.number_base);
+                classes.push_back({i, cls, cls, rule.number_base == decimal});
+            }
+
+            if (rule.has_language) {
+                switch (rule.text_language) {
+                    case eng:
+                        classes.push_back({i, simd::byte_class::lower, simd::byte_class::lower, false});
+                        break;
+                    case ENG:
+                        classes.push_back({i, simd::byte_class::upper, simd::byte_class::upper, false});
+                        break;
+                    case Eng:
+                        classes.push_back({i, simd::byte_class::upper, simd::byte_class::lower, false});
+                        break;
+                    case EnG:
+                        classes.push_back({i, simd::byte_class::alpha, simd::byte_class::alpha, false});
+                        break;
+                    case rus:
+                        cyrillic.push_back({i, simd::cyrillic_class::lower, simd::cyrillic_class::lower});
+                        break;
+                    case RUS:
+                        cyrillic.push_back({i, simd::cyrillic_class::upper, simd::cyrillic_class::upper});
+                        break;
+                    case Rus:
+                        cyrillic.push_back({i, simd::cyrillic_class::upper, simd::cyrillic_class::lower});
+                        break;
+                    case RuS:
+                        cyrillic.push_back({i, simd::cyrillic_class::alpha, simd::cyrillic_class::alpha});
+                        break;
+                    default:
+                        throw WrongLanguageException();
+                }
+            }
+
+            if (rule.automaton) automata.push_back({i, rule.automaton});
+            if (rule.has_date) dates.push_back({i, rule.dates});
+            if (rule.regex) regexes.push_back({i, rule.regex});
+        }
+    }
+
+    field_mask record_schema::validate(const std::string_view *row, std::size_t count) const noexcept {
+        if (count > fields) count = fields;
+        field_mask present = count == max_fields ? ~field_mask{0} : bit(count) - 1;
+        field_mask empty = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            empty |= static_cast<field_mask>(row[i].empty()) << i;
+        }
+
+        // Сбрасываем биты непрошедших полей; поля за пределами строки пропускаем
+        field_mask failed = 0;
+        for (const auto &step: lengths) {
+            if (step.field >= count) continue;
+            failed |= static_cast<field_mask>(row[step.field].size() != step.length) << step.field;
+        }
+        for (const auto &step: classes) {
+            if (step.field >= count) continue;
+            std::string_view f = row[step.field];
+            std::size_t start = step.sign && !f.empty() && (f[0] == '+' || f[0] == '-');
+            bool ok = start < f.size() &&
+                      simd::all_of(f.data() + start, 1, step.first) &&
+                      simd::all_of(f.data() + start + 1, f.size() - start - 1, step.rest);
+            failed |= static_cast<field_mask>(!ok) << step.field;
+        }
+        for (const auto &step: cyrillic) {
+            if (step.field >= count) continue;
+            std::string_view f = row[step.field];
+            bool ok = f.size() >= 2 &&
+                      simd::first_not_cyrillic(f.data(), 2, step.first) == 2 &&
+                      simd::first_not_cyrillic(f.data() + 2, f.size() - 2, step.rest) == f.size() - 2;
+            failed |= static_cast<field_mask>(!ok) << step.field;
+        }
+        for (const auto &step: ranges) {
+            if (step.field >= count) continue;
+            bool ok = static_cast<bool>(parse_number<long long>(row[step.field], step.base,
+                                                                step.left, step.right, step.inside));
+            failed |= static_cast<field_mask>(!ok) << step.field;
+        }
+        for (const auto &step: automata) {
+            if (step.field >= count) continue;
+            failed |= static_cast<field_mask>(!step.automaton->match(row[step.field])) << step.field;
+        }
+        for (const auto &step: dates) {
+            if (step.field >= count) continue;
+            failed |= static_cast<field_mask>(!is_date(row[step.field], step.format)) << step.field;
+        }
+        for (const auto &step: regexes) {
+            if (step.field >= count) continue;
+            std::string_view f = row[step.field];
+            bool ok;
+            try {
+                ok = std::regex_match(f.begin(), f.end(), *step.regex);
+            } catch (...) {
+                ok = false;
+            }
+            failed |= static_cast<field_mask>(!ok) << step.field;
+        }
+
+        // Пустые поля проходят только если объявлены необязательными
+        return (present & ~failed & ~empty) | (present & empty & optional_fields);
+    }
+
+    field_mask record_schema::validate_line(std::string_view line, char delimiter) const noexcept {
+        std::string_view row[max_fields];
+        return validate(row, split_fields(line, delimiter, row, fields));
+    }
+
+    bool record_schema::accepts_line(std::string_view line, char delimiter) const noexcept {
+        std::string_view row[max_fields];
+        std::size_t count = split_fields(line, delimiter, row, fields);
+        return count == fields && validate(row, count) == all;
+    }
+
+    std::size_t split_fields(std::string_view line, char delimiter,
+                             std::string_view *fields, std::size_t capacity) noexcept {
+        std::size_t count = 0;
+        std::size_t start = 0;
+        while (true) {
+            std::size_t stop = line.find(delimiter, start);
+            if (count < capacity) fields[count] = line.substr(start, stop - start);
+            ++count;
+            if (stop == std::string_view::npos) return count;
+            start = stop + 1;
+        }
+    }
+
+} // inpch
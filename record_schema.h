@@ -0,0 +1,156 @@
+#ifndef INPUTCHECK_RECORD_SCHEMA_H
+#define INPUTCHECK_RECORD_SCHEMA_H
+
+#include "input_check.h"
+#include "date_check.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace inpch {
+
+    // Набор проверок одного поля записи; все заданные проверки должны пройти.
+    // Шаблоны не копируются и должны жить дольше схемы.
+    class field_rule {
+    public:
+        field_rule &length(int length) noexcept;
+
+        field_rule &base(const base_type &base) noexcept;
+
+        field_rule &lang(const language &lang) noexcept;
+
+        // Поле - целое число в системе base (по умолчанию decimal), лежащее в [left, right]
+        // при inside, иначе - вне этого отрезка
+        field_rule &range(long long left, long long right, bool inside = true) noexcept;
+
+        field_rule &match(const dfa_pattern &pattern);
+
+        field_rule &match(const std::regex &regex) noexcept;
+
+        // Поле - дата или дата со временем по календарю (см. parse_date)
+        field_rule &date(date_format format = date_format::any) noexcept;
+
+        // Пустое поле допустимо и не проверяется; иначе оно отклоняется, как в input_check
+        field_rule &optional() noexcept;
+
+    private:
+        friend class record_schema;
+
+        int expected_length = any_length;
+        base_type number_base = not_a_number;
+        bool has_language = false;
+        language text_language = eng;
+        bool has_range = false;
+        bool range_inside = true;
+        long long range_left = 0;
+        long long range_right = 0;
+        const dfa *automaton = nullptr;
+        const std::regex *regex = nullptr;
+        bool has_date = false;
+        date_format dates = date_format::any;
+        bool may_be_empty = false;
+    };
+
+    // Бит i установлен, если поле i прошло проверку
+    using field_mask = std::uint64_t;
+
+    // Схема записи, скомпилированная в плоский план: проверки одного вида собраны
+    // в отдельные массивы и выполняются подряд, без ветвления по виду для каждого поля.
+    // Проверка строки не выделяет память (кроме правил со std::regex).
+    class record_schema {
+    public:
+        static constexpr std::size_t max_fields = 64;
+
+        // Бросает std::length_error, если полей больше max_fields,
+        // WrongBaseException и WrongLanguageException при неверных параметрах
+        explicit record_schema(const std::vector<field_rule> &rules);
+
+        std::size_t field_count() const noexcept { return fields; }
+
+        // Маска, в которой установлены биты всех полей схемы
+        field_mask full_mask() const noexcept { return all; }
+
+        // Поля сверх схемы не проверяются, недостающие поля считаются отклонёнными
+        field_mask validate(const std::string_view *row, std::size_t count) const noexcept;
+
+        field_mask validate(const std::vector<std::string_view> &row) const noexcept {
+            return validate(row.data(), row.size());
+        }
+
+        // Строка делится по delimiter без учёта кавычек
+        field_mask validate_line(std::string_view line, char delimiter = ',') const noexcept;
+
+        // Все поля прошли проверку и их ровно field_count()
+        bool accepts(const std::string_view *row, std::size_t count) const noexcept {
+            return count == fields && validate(row, count) == all;
+        }
+
+        bool accepts_line(std::string_view line, char delimiter = ',') const noexcept;
+
+    private:
+        struct length_step {
+            std::uint32_t field;
+            std::size_t length;
+        };
+
+        // Цифры системы счисления или английские буквы: первый символ проверяется
+        // классом first, остальные - классом rest; sign разрешает ведущий знак
+        struct class_step {
+            std::uint32_t field;
+            simd::byte_class first;
+            simd::byte_class rest;
+            bool sign;
+        };
+
+        // Кириллица в UTF-8: первая буква (два байта) проверяется классом first,
+        // остальные - классом rest
+        struct cyrillic_step {
+            std::uint32_t field;
+            simd::cyrillic_class first;
+            simd::cyrillic_class rest;
+        };
+
+        struct range_step {
+            std::uint32_t field;
+            base_type base;
+            long long left;
+            long long right;
+            bool inside;
+        };
+
+        struct dfa_step {
+            std::uint32_t field;
+            const dfa *automaton;
+        };
+
+        struct date_step {
+            std::uint32_t field;
+            date_format format;
+        };
+
+        struct regex_step {
+            std::uint32_t field;
+            const std::regex *regex;
+        };
+
+        std::size_t fields;
+        field_mask all;
+        field_mask optional_fields = 0;
+        std::vector<length_step> lengths;
+        std::vector<class_step> classes;
+        std::vector<cyrillic_step> cyrillic;
+        std::vector<range_step> ranges;
+        std::vector<dfa_step> automata;
+        std::vector<date_step> dates;
+        std::vector<regex_step> regexes;
+    };
+
+    // Делит line по delimiter и записывает не больше capacity полей в fields.
+    // Возвращает общее число полей в строке, которое может превышать capacity.
+    std::size_t split_fields(std::string_view line, char delimiter,
+                             std::string_view *fields, std::size_t capacity) noexcept;
+
+} // inpch
+
+#endif //INPUTCHECK_RECORD_SCHEMA_H
@@ -0,0 +1,102 @@
+#include "regex_cache.h"
+
+#include <mutex>
+
+namespace inpch {
+
+    regex_cache::regex_cache(std::size_t capacity, std::size_t shard_count) {
+        if (shard_count == 0) shard_count = 1;
+        if (capacity < shard_count) capacity = shard_count;
+        shard_capacity = (capacity + shard_count - 1) / shard_count;
+        shards.reserve(shard_count);
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            shards.push_back(std::make_unique<shard>());
+            shards.back()->slots.reserve(shard_capacity);
+        }
+    }
+
+    std::shared_ptr<const std::regex> regex_cache::get(const std::string &pattern, flag_type flags) {
+        const key lookup{pattern, flags};
+        shard &s = *shards[(key_hash()(lookup) >> 7) % shards.size()];
+
+        {
+            std::shared_lock<std::shared_mutex> lock(s.mutex);
+            auto it = s.index.find(lookup);
+            if (it != s.index.end()) {
+                entry &e = *s.slots[it->second];
+                e.referenced.store(true, std::memory_order_relaxed);
+                s.hits.fetch_add(1, std::memory_order_relaxed);
+                return e.regex;
+            }
+        }
+
+        // Компиляция идёт вне блокировки, чтобы не задерживать другие потоки
+        s.misses.fetch_add(1, std::memory_order_relaxed);
+        auto compiled = std::make_shared<const std::regex>(pattern, flags);
+
+        std::unique_lock<std::shared_mutex> lock(s.mutex);
+        auto it = s.index.find(lookup);
+        if (it != s.index.end()) {
+            return s.slots[it->second]->regex;
+        }
+
+        auto fresh = std::make_unique<entry>();
+        fresh->pattern = pattern;
+        fresh->flags = flags;
+        fresh->regex = compiled;
+
+        std::size_t slot;
+        if (s.slots.size() < shard_capacity) {
+            slot = s.slots.size();
+            s.slots.push_back(std::move(fresh));
+        } else {
+            // CLOCK: стрелка снимает флаги обращения, пока не найдёт запись без него
+            while (s.slots[s.hand]->referenced.exchange(false, std::memory_order_relaxed)) {
+                s.hand = (s.hand + 1) % s.slots.size();
+            }
+            slot = s.hand;
+            s.hand = (s.hand + 1) % s.slots.size();
+            const entry &victim = *s.slots[slot];
+            s.index.erase(key{victim.pattern, victim.flags});
+            s.slots[slot] = std::move(fresh);
+            s.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        s.index.emplace(key{s.slots[slot]->pattern, flags}, slot);
+        return compiled;
+    }
+
+    regex_cache_stats regex_cache::stats() const {
+        regex_cache_stats result{0, 0, 0, 0, shard_capacity * shards.size()};
+        for (const auto &s: shards) {
+            result.hits += s->hits.load(std::memory_order_relaxed);
+            result.misses += s->misses.load(std::memory_order_relaxed);
+            result.evictions += s->evictions.load(std::memory_order_relaxed);
+            std::shared_lock<std::shared_mutex> lock(s->mutex);
+            result.size += s->slots.size();
+        }
+        return result;
+    }
+
+    void regex_cache::clear() {
+        for (auto &s: shards) {
+            std::unique_lock<std::shared_mutex> lock(s->mutex);
+            s->index.clear();
+            s->slots.clear();
+            s->hand = 0;
+        }
+    }
+
+    regex_cache &default_regex_cache() {
+        static regex_cache cache;
+        return cache;
+    }
+
+    const std::regex &regex_pattern::compile() const {
+        std::call_once(once, [this] {
+            storage = std::make_unique<std::regex>(source, options);
+            compiled.store(storage.get(), std::memory_order_release);
+        });
+        return *storage;
+    }
+
+} // inpch
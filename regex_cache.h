@@ -0,0 +1,123 @@
+#ifndef INPUTCHECK_REGEX_CACHE_H
+#define INPUTCHECK_REGEX_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace inpch {
+
+    struct regex_cache_stats {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+        std::size_t size;
+        std::size_t capacity;
+    };
+
+    // Ограниченный кэш скомпилированных std::regex с ключом (шаблон, флаги).
+    // Ключи распределены по сегментам; поиск берёт разделяемую блокировку одного
+    // сегмента, вытеснение внутри сегмента - по алгоритму CLOCK.
+    class regex_cache {
+    public:
+        using flag_type = std::regex_constants::syntax_option_type;
+
+        explicit regex_cache(std::size_t capacity = 256, std::size_t shard_count = 16);
+
+        regex_cache(const regex_cache &) = delete;
+
+        regex_cache &operator=(const regex_cache &) = delete;
+
+        // Бросает std::regex_error, если шаблон не компилируется
+        std::shared_ptr<const std::regex> get(const std::string &pattern,
+                                              flag_type flags = std::regex_constants::ECMAScript);
+
+        regex_cache_stats stats() const;
+
+        void clear();
+
+    private:
+        struct key {
+            std::string_view pattern;
+            flag_type flags;
+
+            bool operator==(const key &other) const noexcept {
+                return flags == other.flags && pattern == other.pattern;
+            }
+        };
+
+        struct key_hash {
+            std::size_t operator()(const key &k) const noexcept {
+                return std::hash<std::string_view>()(k.pattern) ^ (static_cast<std::size_t>(k.flags) * 0x9E3779B97F4A7C15ull);
+            }
+        };
+
+        struct entry {
+            std::string pattern;
+            flag_type flags;
+            std::shared_ptr<const std::regex> regex;
+            std::atomic<bool> referenced{true};
+        };
+
+        struct alignas(64) shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<key, std::size_t, key_hash> index;
+            std::vector<std::unique_ptr<entry>> slots;
+            std::size_t hand = 0;
+            std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> evictions{0};
+        };
+
+        std::size_t shard_capacity;
+        std::vector<std::unique_ptr<shard>> shards;
+    };
+
+    // Кэш, через который работает input_match(const std::string &, const std::string &)
+    regex_cache &default_regex_cache();
+
+    // std::regex, который компилируется при первом использовании, а не при запуске
+    // программы. Конструктор constexpr, так что глобальные шаблоны ничего не стоят,
+    // пока к ним не обратились. Приводится к const std::regex &; в шаблонных функциях
+    // вроде std::regex_match нужен явный get().
+    class regex_pattern {
+    public:
+        using flag_type = std::regex_constants::syntax_option_type;
+
+        constexpr explicit regex_pattern(const char *pattern, flag_type flags = std::regex_constants::ECMAScript) noexcept
+                : source(pattern), options(flags) {}
+
+        regex_pattern(const regex_pattern &) = delete;
+
+        regex_pattern &operator=(const regex_pattern &) = delete;
+
+        // Бросает std::regex_error, если шаблон не компилируется
+        const std::regex &get() const {
+            if (const std::regex *ready = compiled.load(std::memory_order_acquire)) return *ready;
+            return compile();
+        }
+
+        operator const std::regex &() const { return get(); }
+
+        const char *pattern() const noexcept { return source; }
+
+    private:
+        const char *source;
+        flag_type options;
+        mutable std::once_flag once;
+        mutable std::unique_ptr<std::regex> storage;
+        mutable std::atomic<const std::regex *> compiled{nullptr};
+
+        const std::regex &compile() const;
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_REGEX_CACHE_H
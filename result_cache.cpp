@@ -0,0 +1,209 @@
+#include "result_cache.h"
+
+#include <algorithm>
+
+namespace inpch {
+
+    namespace {
+
+        std::size_t word_count(std::size_t size) noexcept {
+            return size == 0 ? 0 : size < 8 ? 1 : (size + 7) / 8;
+        }
+
+        // Слово w входа; последнее слово длинного входа перекрывает предпоследнее.
+        // При равной длине слова совпадают тогда и только тогда, когда совпадают байты
+        std::uint64_t key_word(const char *data, std::size_t size, std::size_t w) noexcept {
+            if (size < 8) return result_cache::short_word(data, size);
+            std::uint64_t word;
+            std::memcpy(&word, data + std::min(w * 8, size - 8), 8);
+            return word;
+        }
+
+    } // namespace
+
+    result_cache::result_cache(const result_cache_options &options)
+            : max_input(std::min<std::size_t>(options.max_input, 0xFFFF)),
+              key_words(word_count(max_input)),
+              admission(options.admission) {
+        std::size_t shard_count = options.shard_count == 0 ? 1 : options.shard_count;
+        std::size_t per_shard = (options.capacity + shard_count - 1) / shard_count;
+        set_count = per_shard < set_ways ? 1 : (per_shard + set_ways - 1) / set_ways;
+        const std::size_t slots = set_count * set_ways;
+
+        shards.reserve(shard_count);
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            auto s = std::make_unique<shard>();
+            s->versions = std::make_unique<std::atomic<std::uint32_t>[]>(set_count);
+            s->slots = std::make_unique<slot[]>(slots);
+            s->words = std::make_unique<std::atomic<std::uint64_t>[]>(slots * key_words + 1);
+            // Привратник: два бита на хеш, четыре слова на набор
+            if (admission == cache_admission::repeated) s->doorkeeper.assign(set_count * 4, 0);
+            shards.push_back(std::move(s));
+        }
+    }
+
+    bool result_cache::find(std::uint64_t hash, spec_id spec, std::string_view input, check_result &result) noexcept {
+        shard &s = shard_of(hash);
+        const std::size_t set = set_of(hash);
+        const std::size_t words = word_count(input.size());
+        std::atomic<std::uint32_t> &version = s.versions[set];
+
+        const std::uint32_t before = version.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            for (std::size_t k = set * set_ways; k < (set + 1) * set_ways; ++k) {
+                slot &e = s.slots[k];
+                if (e.hash.load(std::memory_order_relaxed) != hash || e.spec.load(std::memory_order_relaxed) != spec) {
+                    continue;
+                }
+                const std::uint64_t meta = e.meta.load(std::memory_order_relaxed);
+                if (!(meta & used_bit) || ((meta >> 32) & 0xFFFF) != input.size()) continue;
+
+                const std::atomic<std::uint64_t> *stored = &s.words[k * key_words];
+                std::size_t w = 0;
+                while (w < words && stored[w].load(std::memory_order_relaxed) ==
+                                    key_word(input.data(), input.size(), w)) {
+                    ++w;
+                }
+                if (w != words) continue;
+
+                // Запись могла идти одновременно: тогда прочитанное не годится
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (version.load(std::memory_order_relaxed) != before) break;
+
+                // Запись в общую строку кэша только при смене флага
+                if (e.referenced.load(std::memory_order_relaxed) == 0) {
+                    e.referenced.store(1, std::memory_order_relaxed);
+                }
+                result = {static_cast<std::size_t>(meta & 0xFFFFFFFFu), static_cast<check_error>((meta >> 48) & 0xFF)};
+                s.hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        s.misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool result_cache::admit(shard &s, std::uint64_t hash) noexcept {
+        if (admission == cache_admission::always) return true;
+
+        const std::size_t bits = s.doorkeeper.size() * 64;
+        const std::size_t a = (hash >> 8) % bits;
+        const std::size_t b = (hash >> 40) % bits;
+        const std::uint64_t mask_a = std::uint64_t{1} << (a % 64);
+        const std::uint64_t mask_b = std::uint64_t{1} << (b % 64);
+        if ((s.doorkeeper[a / 64] & mask_a) && (s.doorkeeper[b / 64] & mask_b)) return true;
+
+        // Привратник старится: после стольких отметок, сколько записей в сегменте,
+        // он очищается, чтобы давно встреченные значения не считались повторными
+        if (++s.doorkeeper_marks > set_count * set_ways) {
+            std::fill(s.doorkeeper.begin(), s.doorkeeper.end(), 0);
+            s.doorkeeper_marks = 1;
+        }
+        s.doorkeeper[a / 64] |= mask_a;
+        s.doorkeeper[b / 64] |= mask_b;
+        return false;
+    }
+
+    void result_cache::store(std::uint64_t hash, spec_id spec, std::string_view input,
+                             const check_result &result) noexcept {
+        shard &s = shard_of(hash);
+        const std::size_t set = set_of(hash);
+        const std::size_t first = set * set_ways;
+        const std::size_t words = word_count(input.size());
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!admit(s, hash)) {
+            s.rejected.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Под блокировкой писатель один, поэтому поля читаются без seqlock
+        std::size_t victim = first + set_ways;
+        for (std::size_t k = first; k < first + set_ways; ++k) {
+            const slot &e = s.slots[k];
+            const std::uint64_t meta = e.meta.load(std::memory_order_relaxed);
+            if (!(meta & used_bit)) {
+                if (victim == first + set_ways) victim = k;
+                continue;
+            }
+            // Другой поток успел вставить то же значение
+            if (e.hash.load(std::memory_order_relaxed) == hash && e.spec.load(std::memory_order_relaxed) == spec &&
+                ((meta >> 32) & 0xFFFF) == input.size()) {
+                std::size_t w = 0;
+                while (w < words && s.words[k * key_words + w].load(std::memory_order_relaxed) ==
+                                    key_word(input.data(), input.size(), w)) {
+                    ++w;
+                }
+                if (w == words) return;
+            }
+        }
+        if (victim == first + set_ways) {
+            // CLOCK внутри набора: начало обхода зависит от хеша, флаги обращения
+            // снимаются, пока не найдётся запись без него
+            std::size_t hand = (hash >> 20) % set_ways;
+            while (s.slots[first + hand].referenced.exchange(0, std::memory_order_relaxed)) {
+                hand = (hand + 1) % set_ways;
+            }
+            victim = first + hand;
+            s.evictions.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            s.size.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Нечётная версия на время записи: поиск в этом наборе даёт промах
+        std::atomic<std::uint32_t> &version = s.versions[set];
+        const std::uint32_t current = version.load(std::memory_order_relaxed);
+        version.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot &e = s.slots[victim];
+        e.hash.store(hash, std::memory_order_relaxed);
+        e.spec.store(spec, std::memory_order_relaxed);
+        e.meta.store((result.position & 0xFFFFFFFFu) | (static_cast<std::uint64_t>(input.size()) << 32) |
+                     (static_cast<std::uint64_t>(result.error) << 48) | used_bit, std::memory_order_relaxed);
+        // Флаг ставит только повторное обращение: значение, встреченное один раз,
+        // вытесняется первым
+        e.referenced.store(0, std::memory_order_relaxed);
+        for (std::size_t w = 0; w < words; ++w) {
+            s.words[victim * key_words + w].store(key_word(input.data(), input.size(), w), std::memory_order_relaxed);
+        }
+
+        version.store(current + 2, std::memory_order_release);
+        s.insertions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    result_cache_stats result_cache::stats() const {
+        result_cache_stats result{0, 0, 0, 0, 0, bypassed.load(std::memory_order_relaxed), 0,
+                                  set_count * set_ways * shards.size()};
+        for (const auto &s: shards) {
+            result.hits += s->hits.load(std::memory_order_relaxed);
+            result.misses += s->misses.load(std::memory_order_relaxed);
+            result.insertions += s->insertions.load(std::memory_order_relaxed);
+            result.rejected += s->rejected.load(std::memory_order_relaxed);
+            result.evictions += s->evictions.load(std::memory_order_relaxed);
+            result.size += s->size.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void result_cache::clear() {
+        for (auto &s: shards) {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            for (std::size_t set = 0; set < set_count; ++set) {
+                std::atomic<std::uint32_t> &version = s->versions[set];
+                const std::uint32_t current = version.load(std::memory_order_relaxed);
+                version.store(current + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (std::size_t k = set * set_ways; k < (set + 1) * set_ways; ++k) {
+                    s->slots[k].meta.store(0, std::memory_order_relaxed);
+                    s->slots[k].referenced.store(0, std::memory_order_relaxed);
+                }
+                version.store(current + 2, std::memory_order_release);
+            }
+            std::fill(s->doorkeeper.begin(), s->doorkeeper.end(), 0);
+            s->doorkeeper_marks = 0;
+            s->size.store(0, std::memory_order_relaxed);
+        }
+    }
+
+} // inpch
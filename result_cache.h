@@ -0,0 +1,201 @@
+#ifndef INPUTCHECK_RESULT_CACHE_H
+#define INPUTCHECK_RESULT_CACHE_H
+
+#include "check_result.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace inpch {
+
+    // Когда промах занимает место в кэше
+    enum class cache_admission {
+        always,  // каждый промах
+        repeated // только значение, которое уже встречалось недавно: разовые значения
+                 // не вытесняют частые
+    };
+
+    struct result_cache_options {
+        // Записей во всех сегментах; память под них выделяется сразу
+        std::size_t capacity = 1u << 16;
+        std::size_t shard_count = 16;
+        // Входы длиннее проверяются без кэша
+        std::size_t max_input = 64;
+        cache_admission admission = cache_admission::always;
+    };
+
+    struct result_cache_stats {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t insertions;
+        std::uint64_t rejected;  // промахи, не допущенные политикой admission
+        std::uint64_t evictions;
+        std::uint64_t bypassed;  // входы длиннее max_input
+        std::size_t size;
+        std::size_t capacity;
+
+        // Доля попаданий среди обращений, прошедших через кэш
+        double hit_rate() const noexcept {
+            return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+    };
+
+    // Кэш результатов проверок с ключом (проверка, байты входа) и фиксированной
+    // памятью. Сегмент - таблица из наборов по set_ways записей; запись ищется
+    // только в своём наборе, вытеснение внутри набора - по алгоритму CLOCK.
+    // Вставка берёт блокировку сегмента, поиск идёт без блокировок: у набора есть
+    // счётчик версий (seqlock), и поиск, совпавший с записью в набор, считается промахом.
+    //
+    // spec_id различает проверки: адрес шаблона (std::regex, dfa) или хеш его
+    // текста, см. spec_of и spec_of_text. Если шаблон с таким адресом уничтожен
+    // и создан заново, кэш нужно очистить.
+    class result_cache {
+    public:
+        using spec_id = std::uint64_t;
+
+        static constexpr std::size_t set_ways = 8;
+
+        explicit result_cache(const result_cache_options &options = {});
+
+        result_cache(const result_cache &) = delete;
+
+        result_cache &operator=(const result_cache &) = delete;
+
+        // Результат из кэша или check(), который затем сохраняется
+        template<class Check>
+        check_result get_or_check(spec_id spec, std::string_view input, Check &&check) {
+            if (input.size() > max_input) {
+                bypassed.fetch_add(1, std::memory_order_relaxed);
+                return check();
+            }
+            const std::uint64_t hash = hash_of(spec, input);
+            check_result result;
+            if (find(hash, spec, input, result)) return result;
+            result = check();
+            store(hash, spec, input, result);
+            return result;
+        }
+
+        bool find(spec_id spec, std::string_view input, check_result &result) noexcept {
+            return input.size() <= max_input && find(hash_of(spec, input), spec, input, result);
+        }
+
+        void insert(spec_id spec, std::string_view input, const check_result &result) noexcept {
+            if (input.size() <= max_input) store(hash_of(spec, input), spec, input, result);
+        }
+
+        result_cache_stats stats() const;
+
+        void clear();
+
+        // Хеш байтов: по 8 байт за шаг, хвост - перекрывающимися загрузками постоянной
+        // длины (memcpy переменной длины стал бы вызовом функции), затем
+        // перемешивание как в MurmurHash3
+        static std::uint64_t hash_bytes(const char *data, std::size_t size, std::uint64_t seed) noexcept {
+            std::uint64_t h = seed ^ (size * 0x9E3779B97F4A7C15ull);
+            auto mix = [&h](std::uint64_t word) noexcept {
+                h = (h ^ word) * 0xBF58476D1CE4E5B9ull;
+                h ^= h >> 31;
+            };
+            if (size >= 8) {
+                std::uint64_t word;
+                std::size_t i = 0;
+                for (; i + 8 <= size; i += 8) {
+                    std::memcpy(&word, data + i, 8);
+                    mix(word);
+                }
+                if (i < size) {
+                    std::memcpy(&word, data + size - 8, 8);
+                    mix(word);
+                }
+            } else if (size > 0) {
+                mix(short_word(data, size));
+            }
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        // Вход короче 8 байт одним словом; вместе с длиной однозначно задаёт байты
+        static std::uint64_t short_word(const char *data, std::size_t size) noexcept {
+            if (size >= 4) {
+                std::uint32_t first, last;
+                std::memcpy(&first, data, 4);
+                std::memcpy(&last, data + size - 4, 4);
+                return first | (static_cast<std::uint64_t>(last) << 32);
+            }
+            return static_cast<std::uint64_t>(static_cast<unsigned char>(data[0])) |
+                   static_cast<std::uint64_t>(static_cast<unsigned char>(data[size / 2])) << 8 |
+                   static_cast<std::uint64_t>(static_cast<unsigned char>(data[size - 1])) << 16;
+        }
+
+        // Проверка, заданная адресом объекта (std::regex, dfa)
+        static spec_id spec_of(const void *identity) noexcept {
+            return static_cast<spec_id>(reinterpret_cast<std::uintptr_t>(identity));
+        }
+
+        // Проверка, заданная текстом шаблона; младший бит отличает её от адресов
+        static spec_id spec_of_text(std::string_view pattern, std::uint64_t flags = 0) noexcept {
+            return hash_bytes(pattern.data(), pattern.size(), flags) | 1u;
+        }
+
+    private:
+        // Поля записи атомарны, чтобы чтение без блокировки шло одновременно с записью;
+        // meta = position | length << 32 | error << 48 | used << 56
+        struct slot {
+            std::atomic<std::uint64_t> hash{0};
+            std::atomic<spec_id> spec{0};
+            std::atomic<std::uint64_t> meta{0};
+            std::atomic<std::uint8_t> referenced{0};
+        };
+
+        struct alignas(64) shard {
+            std::mutex mutex; // только для вставки
+            std::unique_ptr<std::atomic<std::uint32_t>[]> versions; // по одной на набор
+            std::unique_ptr<slot[]> slots;
+            std::unique_ptr<std::atomic<std::uint64_t>[]> words;    // байты входов, key_words на запись
+            std::vector<std::uint64_t> doorkeeper;                  // хеши, встреченные один раз
+            std::size_t doorkeeper_marks = 0;
+            std::atomic<std::size_t> size{0};
+            std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> insertions{0};
+            std::atomic<std::uint64_t> rejected{0};
+            std::atomic<std::uint64_t> evictions{0};
+        };
+
+        static constexpr std::uint64_t used_bit = std::uint64_t{1} << 56;
+
+        std::size_t max_input;
+        std::size_t key_words;   // 64-битных слов на вход длины max_input
+        cache_admission admission;
+        std::size_t set_count;   // наборов в сегменте
+        std::vector<std::unique_ptr<shard>> shards;
+        std::atomic<std::uint64_t> bypassed{0};
+
+        static std::uint64_t hash_of(spec_id spec, std::string_view input) noexcept {
+            return hash_bytes(input.data(), input.size(), spec);
+        }
+
+        shard &shard_of(std::uint64_t hash) const noexcept { return *shards[hash % shards.size()]; }
+
+        std::size_t set_of(std::uint64_t hash) const noexcept { return (hash >> 32) % set_count; }
+
+        bool find(std::uint64_t hash, spec_id spec, std::string_view input, check_result &result) noexcept;
+
+        void store(std::uint64_t hash, spec_id spec, std::string_view input, const check_result &result) noexcept;
+
+        bool admit(shard &s, std::uint64_t hash) noexcept;
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_RESULT_CACHE_H
@@ -0,0 +1,142 @@
+#ifndef INPUTCHECK_RING_QUEUE_H
+#define INPUTCHECK_RING_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace inpch {
+
+    namespace ring_detail {
+
+        inline std::size_t round_up_pow2(std::size_t n) noexcept {
+            std::size_t size = 2;
+            while (size < n) size *= 2;
+            return size;
+        }
+
+    } // namespace ring_detail
+
+    // Ограниченная очередь без блокировок для одного производителя и одного
+    // потребителя. Каждая сторона держит копию чужого индекса и перечитывает
+    // общий только когда копия говорит, что очередь полна (пуста)
+    template<class T>
+    class spsc_ring {
+        static_assert(std::is_nothrow_move_assignable<T>::value, "spsc_ring: T must be nothrow movable");
+
+    public:
+        // Ёмкость округляется вверх до степени двойки
+        explicit spsc_ring(std::size_t capacity)
+                : mask(ring_detail::round_up_pow2(capacity) - 1), cells(new T[mask + 1]) {}
+
+        std::size_t capacity() const noexcept { return mask + 1; }
+
+        // Только производитель
+        bool try_push(T value) noexcept {
+            const std::size_t tail = producer.position.load(std::memory_order_relaxed);
+            if (tail - producer.other == mask + 1) {
+                producer.other = consumer.position.load(std::memory_order_acquire);
+                if (tail - producer.other == mask + 1) return false;
+            }
+            cells[tail & mask] = std::move(value);
+            producer.position.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Только потребитель
+        bool try_pop(T &value) noexcept {
+            const std::size_t head = consumer.position.load(std::memory_order_relaxed);
+            if (head == consumer.other) {
+                consumer.other = producer.position.load(std::memory_order_acquire);
+                if (head == consumer.other) return false;
+            }
+            value = std::move(cells[head & mask]);
+            consumer.position.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        // Индекс стороны и её копия индекса другой стороны - в своей строке кэша
+        struct alignas(64) side {
+            std::atomic<std::size_t> position{0};
+            std::size_t other = 0;
+        };
+
+        const std::size_t mask;
+        std::unique_ptr<T[]> cells;
+        side producer;
+        side consumer;
+    };
+
+    // Ограниченная очередь без блокировок для многих производителей и потребителей
+    // (схема Д. Вьюкова): у ячейки свой счётчик, по которому сторона узнаёт, что
+    // ячейка свободна (занята) на этом круге, и занимает её одним CAS своего индекса
+    template<class T>
+    class mpmc_ring {
+        static_assert(std::is_nothrow_move_assignable<T>::value, "mpmc_ring: T must be nothrow movable");
+
+    public:
+        // Ёмкость округляется вверх до степени двойки
+        explicit mpmc_ring(std::size_t capacity)
+                : mask(ring_detail::round_up_pow2(capacity) - 1), cells(new cell[mask + 1]) {
+            for (std::size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity() const noexcept { return mask + 1; }
+
+        bool try_push(T value) noexcept {
+            std::size_t position = tail.load(std::memory_order_relaxed);
+            while (true) {
+                cell &c = cells[position & mask];
+                const std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+                const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+                if (lag == 0) {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        c.value = std::move(value);
+                        c.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (lag < 0) {
+                    return false; // ячейка ещё не прочитана с прошлого круга: очередь полна
+                } else {
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool try_pop(T &value) noexcept {
+            std::size_t position = head.load(std::memory_order_relaxed);
+            while (true) {
+                cell &c = cells[position & mask];
+                const std::size_t sequence = c.sequence.load(std::memory_order_acquire);
+                const auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+                if (lag == 0) {
+                    if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        value = std::move(c.value);
+                        c.sequence.store(position + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (lag < 0) {
+                    return false; // ячейка ещё не записана: очередь пуста
+                } else {
+                    position = head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        struct alignas(64) cell {
+            std::atomic<std::size_t> sequence{0};
+            T value{};
+        };
+
+        const std::size_t mask;
+        std::unique_ptr<cell[]> cells;
+        alignas(64) std::atomic<std::size_t> tail{0};
+        alignas(64) std::atomic<std::size_t> head{0};
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_RING_QUEUE_H
@@ -0,0 +1,242 @@
+#ifndef INPUTCHECK_STATIC_CHECK_H
+#define INPUTCHECK_STATIC_CHECK_H
+
+#include "input_check.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Проверка в константном выражении идёт скалярным циклом, во время выполнения
+// строки проверяются ядрами input_simd
+#if defined(__cpp_lib_is_constant_evaluated)
+#define INPCH_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define INPCH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define INPCH_CONSTANT_EVALUATED() true
+#endif
+
+namespace inpch {
+
+    // Параметры static_check. Каждый задаётся не больше одного раза; система
+    // счисления и язык вместе не допускаются
+    namespace policy {
+
+        struct tag {
+            static constexpr bool is_length = false;
+            static constexpr bool is_base = false;
+            static constexpr bool is_lang = false;
+        };
+
+        template<int Length>
+        struct length : tag {
+            static_assert(Length >= 0, "length must not be negative");
+            static constexpr bool is_length = true;
+            static constexpr int value = Length;
+        };
+
+        template<base_type Base>
+        struct base : tag {
+            static_assert(Base == decimal || Base == octal || Base == hexadecimal || Base == binary ||
+                          Base == not_a_number, "unsupported base_type");
+            static constexpr bool is_base = true;
+            static constexpr base_type value = Base;
+        };
+
+        template<language Lang>
+        struct lang : tag {
+            static_assert(Lang >= rus && Lang <= EnG, "unsupported language");
+            static constexpr bool is_lang = true;
+            static constexpr language value = Lang;
+        };
+
+    } // namespace policy
+
+    // Проверка с параметрами на этапе компиляции: static_check<policy::length<6>, policy::base<hexadecimal>>.
+    // Результат тот же, что у check_base/check_language, но без выбора по base и lang
+    // во время выполнения. Годится для constexpr:
+    //     static_assert(static_check<policy::lang<Eng>>::test("Hello"));
+    // Узкие строки, как и в first_not_of_language, считаются UTF-8.
+    template<class... Policies>
+    class static_check {
+        static_assert((std::is_base_of<policy::tag, Policies>::value && ...),
+                      "static_check accepts only policy::length, policy::base and policy::lang");
+        static_assert((0 + ... + Policies::is_length) <= 1, "length is given more than once");
+        static_assert((0 + ... + Policies::is_base) <= 1, "base is given more than once");
+        static_assert((0 + ... + Policies::is_lang) <= 1, "language is given more than once");
+        static_assert((0 + ... + Policies::is_base) + (0 + ... + Policies::is_lang) <= 1,
+                      "a field is checked either as a number or as a text");
+
+        template<class P>
+        static constexpr int length_of() noexcept {
+            if constexpr (P::is_length) return P::value;
+            else return 0;
+        }
+
+        template<class P>
+        static constexpr int base_of() noexcept {
+            if constexpr (P::is_base) return P::value;
+            else return 0;
+        }
+
+        template<class P>
+        static constexpr int lang_of() noexcept {
+            if constexpr (P::is_lang) return P::value;
+            else return 0;
+        }
+
+    public:
+        static constexpr bool has_length = (false || ... || Policies::is_length);
+        static constexpr bool has_lang = (false || ... || Policies::is_lang);
+        static constexpr int length = has_length ? (0 + ... + length_of<Policies>()) : any_length;
+        static constexpr base_type base = static_cast<base_type>((0 + ... + base_of<Policies>()));
+        static constexpr language lang = static_cast<language>((0 + ... + lang_of<Policies>()));
+
+        template<class C>
+        static constexpr check_result check(std::basic_string_view<C> input) noexcept {
+            static_assert(std::is_same<C, char>::value || std::is_same<C, wchar_t>::value ||
+                          std::is_same<C, char16_t>::value || std::is_same<C, char32_t>::value,
+                          "static_check works with character strings");
+            if (input.empty()) return {0, check_error::empty_input};
+            if constexpr (has_length) {
+                constexpr auto expected = static_cast<std::size_t>(length);
+                if (input.size() != expected) {
+                    return {input.size() < expected ? input.size() : expected, check_error::wrong_length};
+                }
+            }
+            std::size_t bad = first_bad(input.data(), input.size());
+            if (bad != input.size()) return {bad, check_error::wrong_character};
+            return {input.size(), check_error::none};
+        }
+
+        // Строковый литерал без завершающего нуля
+        template<class C, std::size_t N>
+        static constexpr check_result check(const C (&literal)[N]) noexcept {
+            return check(std::basic_string_view<C>(literal, N - 1));
+        }
+
+        template<class C, class Traits, class Alloc>
+        static check_result check(const std::basic_string<C, Traits, Alloc> &input) noexcept {
+            return check(std::basic_string_view<C>(input.data(), input.size()));
+        }
+
+        template<class T>
+        static constexpr bool test(const T &input) noexcept {
+            return check(input).ok();
+        }
+
+    private:
+        // Класс байта для систем счисления и английского; для кириллицы не используется
+        static constexpr simd::byte_class first_class() noexcept {
+            if constexpr (has_lang) {
+                return lang == eng ? simd::byte_class::lower :
+                       lang == EnG ? simd::byte_class::alpha : simd::byte_class::upper;
+            } else {
+                return base == binary ? simd::byte_class::binary :
+                       base == octal ? simd::byte_class::octal :
+                       base == hexadecimal ? simd::byte_class::hexadecimal : simd::byte_class::decimal;
+            }
+        }
+
+        static constexpr simd::byte_class rest_class() noexcept {
+            return has_lang && lang == Eng ? simd::byte_class::lower : first_class();
+        }
+
+        static constexpr bool cyrillic = has_lang && (lang == rus || lang == RUS || lang == Rus || lang == RuS);
+
+        static constexpr const alphabet &first_letters() noexcept {
+            return lang == rus ? rus_alphabet : RUS_alphabet;
+        }
+
+        static constexpr bool letter(const alphabet &alpha, char32_t ch) noexcept {
+            if constexpr (lang == RuS) return RUS_alphabet.contains(ch) || rus_alphabet.contains(ch);
+            else return alpha.contains(ch);
+        }
+
+        template<class C>
+        static constexpr std::size_t first_bad(const C *data, std::size_t size) noexcept {
+            if constexpr (!has_lang && base == not_a_number) {
+                (void) data;
+                return size;
+            } else if constexpr (cyrillic && std::is_same<C, char>::value) {
+                return first_bad_utf8(data, size);
+            } else if constexpr (cyrillic) {
+                if (!INPCH_CONSTANT_EVALUATED()) return first_bad_wide(data, size);
+                for (std::size_t i = 0; i < size; ++i) {
+                    if (!letter(i == 0 ? first_letters() : (lang == Rus ? rus_alphabet : first_letters()),
+                                code_point(data[i]))) {
+                        return i;
+                    }
+                }
+                return size;
+            } else {
+                std::size_t start = 0;
+                if constexpr (!has_lang && base == decimal) {
+                    if (data[0] == '+' || data[0] == '-') {
+                        if (size == 1) return 0;
+                        start = 1;
+                    }
+                }
+                if (!simd::in_class(code_point(data[start]), first_class())) return start;
+                ++start;
+                if (!INPCH_CONSTANT_EVALUATED()) {
+                    return start + simd::first_not_of(data + start, size - start, rest_class());
+                }
+                for (std::size_t i = start; i < size; ++i) {
+                    if (!simd::in_class(code_point(data[i]), rest_class())) return i;
+                }
+                return size;
+            }
+        }
+
+        static constexpr simd::cyrillic_class first_cyrillic_class() noexcept {
+            return lang == rus ? simd::cyrillic_class::lower :
+                   lang == RuS ? simd::cyrillic_class::alpha : simd::cyrillic_class::upper;
+        }
+
+        static constexpr simd::cyrillic_class rest_cyrillic_class() noexcept {
+            return lang == Rus ? simd::cyrillic_class::lower : first_cyrillic_class();
+        }
+
+        // Кириллица в широкой строке - по одной кодовой единице на букву
+        template<class C>
+        static std::size_t first_bad_wide(const C *data, std::size_t size) noexcept {
+            if constexpr (first_cyrillic_class() == rest_cyrillic_class()) {
+                return simd::first_not_cyrillic(data, size, first_cyrillic_class());
+            } else {
+                if (simd::first_not_cyrillic(data, 1, first_cyrillic_class()) != 1) return 0;
+                return 1 + simd::first_not_cyrillic(data + 1, size - 1, rest_cyrillic_class());
+            }
+        }
+
+        // Кириллица в UTF-8 - пары байтов; индекс - в байтах, как у simd::first_not_cyrillic
+        static constexpr std::size_t first_bad_utf8(const char *data, std::size_t size) noexcept {
+            if (!INPCH_CONSTANT_EVALUATED()) {
+                constexpr simd::cyrillic_class first = first_cyrillic_class();
+                constexpr simd::cyrillic_class rest = rest_cyrillic_class();
+                if constexpr (first == rest) {
+                    return simd::first_not_cyrillic(data, size, first);
+                } else {
+                    if (simd::first_not_cyrillic(data, size < 2 ? size : 2, first) != 2) return 0;
+                    return 2 + simd::first_not_cyrillic(data + 2, size - 2, rest);
+                }
+            }
+            for (std::size_t i = 0; i < size; i += 2) {
+                if (i + 1 == size) return i;
+                auto lead = static_cast<unsigned char>(data[i]);
+                auto tail = static_cast<unsigned char>(data[i + 1]);
+                if ((lead & 0xE0) != 0xC0 || (tail & 0xC0) != 0x80) return i;
+                char32_t ch = (static_cast<char32_t>(lead & 0x1F) << 6) | (tail & 0x3F);
+                if (!letter(i == 0 ? first_letters() : (lang == Rus ? rus_alphabet : first_letters()), ch)) {
+                    return i;
+                }
+            }
+            return size;
+        }
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_STATIC_CHECK_H
@@ -0,0 +1,195 @@
+#include "stream_check.h"
+
+namespace inpch {
+
+    stream_check::stream_check(const int &length, const base_type &base) {
+        if (length != any_length) expected = length < 0 ? 0 : static_cast<std::size_t>(length);
+        switch (base) {
+            case not_a_number:
+                kind = any_kind;
+                return;
+            case decimal:
+                rest_class = simd::byte_class::decimal;
+                sign = true;
+                break;
+            case octal:
+                rest_class = simd::byte_class::octal;
+                break;
+            case hexadecimal:
+                rest_class = simd::byte_class::hexadecimal;
+                break;
+            case binary:
+                rest_class = simd::byte_class::binary;
+                break;
+            default:
+                throw WrongBaseException();
+        }
+        kind = class_kind;
+        first_class = rest_class;
+    }
+
+    stream_check::stream_check(const language &lang) {
+        switch (lang) {
+            case eng:
+                kind = class_kind;
+                first_class = rest_class = simd::byte_class::lower;
+                return;
+            case ENG:
+                kind = class_kind;
+                first_class = rest_class = simd::byte_class::upper;
+                return;
+            case Eng:
+                kind = class_kind;
+                first_class = simd::byte_class::upper;
+                rest_class = simd::byte_class::lower;
+                return;
+            case EnG:
+                kind = class_kind;
+                first_class = rest_class = simd::byte_class::alpha;
+                return;
+            case rus:
+                kind = cyrillic_kind;
+                first_letter = rest_letter = simd::cyrillic_class::lower;
+                return;
+            case RUS:
+                kind = cyrillic_kind;
+                first_letter = rest_letter = simd::cyrillic_class::upper;
+                return;
+            case Rus:
+                kind = cyrillic_kind;
+                first_letter = simd::cyrillic_class::upper;
+                rest_letter = simd::cyrillic_class::lower;
+                return;
+            case RuS:
+                kind = cyrillic_kind;
+                first_letter = rest_letter = simd::cyrillic_class::alpha;
+                return;
+            default:
+                throw WrongLanguageException();
+        }
+    }
+
+    stream_check::stream_check(const dfa_pattern &pattern) : stream_check(pattern.get()) {}
+
+    stream_check::stream_check(const dfa &automaton) noexcept
+            : kind(dfa_kind), automaton(&automaton), state(automaton.start_state()) {}
+
+    bool stream_check::feed(std::string_view chunk) noexcept {
+        if (rejected()) return false;
+        std::size_t room = (expected < limit ? expected : limit) - total;
+        if (chunk.size() <= room) return scan(chunk);
+
+        // Допустимую часть проверяем, чтобы сообщить о более раннем неверном символе
+        if (scan(chunk.substr(0, room))) reject(total, check_error::wrong_length);
+        return false;
+    }
+
+    check_result stream_check::finish() const noexcept {
+        if (rejected()) return {error_at, error};
+        if (total == 0) return {0, check_error::empty_input};
+        switch (kind) {
+            case class_kind:
+                // Пришёл только знак
+                if (!started) return {0, check_error::wrong_character};
+                break;
+            case cyrillic_kind:
+                // Поле оборвалось посреди двухбайтовой буквы
+                if (has_pending) return {total - 1, check_error::wrong_character};
+                break;
+            case dfa_kind:
+                if (!automaton->is_accepting(state)) return {total, check_error::no_match};
+                break;
+            default:
+                break;
+        }
+        if (expected != unlimited && total != expected) return {total, check_error::wrong_length};
+        return {total, check_error::none};
+    }
+
+    void stream_check::reset() noexcept {
+        total = 0;
+        state = automaton ? automaton->start_state() : dfa::dead_state;
+        started = false;
+        has_pending = false;
+        pending = 0;
+        error = check_error::none;
+        error_at = 0;
+    }
+
+    bool stream_check::scan(std::string_view chunk) noexcept {
+        switch (kind) {
+            case class_kind:
+                return scan_classes(chunk);
+            case cyrillic_kind:
+                return scan_cyrillic(chunk);
+            case dfa_kind: {
+                std::size_t stop = automaton->advance_until_dead(state, chunk);
+                if (state == dfa::dead_state) return reject(total + stop, check_error::no_match);
+                break;
+            }
+            default:
+                break;
+        }
+        total += chunk.size();
+        return true;
+    }
+
+    bool stream_check::scan_classes(std::string_view chunk) noexcept {
+        std::size_t i = 0;
+        if (sign && total == 0 && !chunk.empty() && (chunk[0] == '+' || chunk[0] == '-')) i = 1;
+        if (!started && i < chunk.size()) {
+            if (!simd::all_of(chunk.data() + i, 1, first_class)) return reject(total + i, check_error::wrong_character);
+            started = true;
+            ++i;
+        }
+        std::size_t bad = i + simd::first_not_of(chunk.data() + i, chunk.size() - i, rest_class);
+        if (bad != chunk.size()) return reject(total + bad, check_error::wrong_character);
+        total += chunk.size();
+        return true;
+    }
+
+    bool stream_check::scan_cyrillic(std::string_view chunk) noexcept {
+        if (chunk.empty()) return true;
+        std::size_t i = 0;
+
+        // Дописываем букву, первый байт которой пришёл в прошлой части
+        if (has_pending) {
+            const char pair[2] = {pending, chunk[0]};
+            if (simd::first_not_cyrillic(pair, 2, started ? rest_letter : first_letter) != 2) {
+                return reject(total - 1, check_error::wrong_character);
+            }
+            started = true;
+            has_pending = false;
+            i = 1;
+        }
+        if (!started && chunk.size() - i >= 2) {
+            if (simd::first_not_cyrillic(chunk.data() + i, 2, first_letter) != 2) {
+                return reject(total + i, check_error::wrong_character);
+            }
+            started = true;
+            i += 2;
+        }
+
+        std::size_t pairs = (chunk.size() - i) & ~std::size_t{1};
+        std::size_t bad = simd::first_not_cyrillic(chunk.data() + i, pairs, rest_letter);
+        if (bad != pairs) return reject(total + i + bad, check_error::wrong_character);
+        i += pairs;
+
+        // Оставшийся байт может быть только началом кириллической буквы (0xD0 или 0xD1)
+        if (i < chunk.size()) {
+            auto lead = static_cast<unsigned char>(chunk[i]);
+            if (lead != 0xD0 && lead != 0xD1) return reject(total + i, check_error::wrong_character);
+            pending = chunk[i];
+            has_pending = true;
+        }
+        total += chunk.size();
+        return true;
+    }
+
+    bool stream_check::reject(std::size_t at, check_error why) noexcept {
+        error = why;
+        error_at = at;
+        return false;
+    }
+
+} // inpch
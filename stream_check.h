@@ -0,0 +1,91 @@
+#ifndef INPUTCHECK_STREAM_CHECK_H
+#define INPUTCHECK_STREAM_CHECK_H
+
+#include "input_check.h"
+
+#include <cstddef>
+#include <limits>
+#include <string_view>
+
+namespace inpch {
+
+    // Проверка поля, которое приходит частями (например, из сокета). Состояние
+    // фиксированного размера, части не копируются. Поле отклоняется на первом
+    // недопустимом байте, после чего остальные части можно не читать.
+    // Узкие строки считаются UTF-8, как в first_not_of_language.
+    //
+    // Принимает ровно то же, что check_base, check_language и check_match, но у
+    // отклонённого поля ошибка и позиция могут отличаться: недопустимый символ,
+    // найденный до конца потока, важнее wrong_length. Например, при длине 6
+    // "Y7Y7" - здесь wrong_character в 0, а check_base сначала сравнивает длину
+    // и сообщает wrong_length в min(размер, длина).
+    class stream_check {
+    public:
+        static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+        stream_check(const int &length = any_length, const base_type &base = not_a_number);
+
+        stream_check(const language &lang);
+
+        stream_check(const dfa_pattern &pattern);
+
+        stream_check(const dfa &automaton) noexcept;
+
+        // Поле длиннее max_bytes отклоняется (wrong_length), как только придёт лишний байт
+        void set_max_length(std::size_t max_bytes) noexcept { limit = max_bytes; }
+
+        // Принимает очередную часть. false - поле уже отклонено, дальше можно не подавать
+        bool feed(std::string_view chunk) noexcept;
+
+        // Итог после последней части; позиции отсчитываются от начала поля
+        check_result finish() const noexcept;
+
+        bool rejected() const noexcept { return error != check_error::none; }
+
+        // Сколько байтов поля принято к проверке
+        std::size_t consumed() const noexcept { return total; }
+
+        // Начинает новое поле с теми же правилами
+        void reset() noexcept;
+
+    private:
+        enum kind_type {
+            any_kind,
+            class_kind,
+            cyrillic_kind,
+            dfa_kind
+        };
+
+        kind_type kind = any_kind;
+        // class_kind: первый символ - first_class, остальные - rest_class; sign разрешает знак
+        simd::byte_class first_class = simd::byte_class::decimal;
+        simd::byte_class rest_class = simd::byte_class::decimal;
+        bool sign = false;
+        // cyrillic_kind: то же для букв, пары байтов UTF-8 могут разрываться между частями
+        simd::cyrillic_class first_letter = simd::cyrillic_class::lower;
+        simd::cyrillic_class rest_letter = simd::cyrillic_class::lower;
+        const dfa *automaton = nullptr;
+
+        std::size_t expected = unlimited;
+        std::size_t limit = unlimited;
+
+        std::size_t total = 0;
+        dfa::state_type state = dfa::dead_state;
+        bool started = false;
+        bool has_pending = false;
+        char pending = 0;
+        check_error error = check_error::none;
+        std::size_t error_at = 0;
+
+        bool scan(std::string_view chunk) noexcept;
+
+        bool scan_classes(std::string_view chunk) noexcept;
+
+        bool scan_cyrillic(std::string_view chunk) noexcept;
+
+        bool reject(std::size_t at, check_error why) noexcept;
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_STREAM_CHECK_H
@@ -0,0 +1,106 @@
+#ifndef INPUTCHECK_STRING_POOL_H
+#define INPUTCHECK_STRING_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace inpch {
+
+    // Хранилище строк блоками: байты значений идут подряд внутри блока, массив
+    // представлений указывает на них. Значение не выделяет память само по себе,
+    // а освобождение всего пакета - один reset(), после которого блоки используются снова.
+    // Блоки не перемещаются, поэтому представление значения действительно до reset()
+    // при любом числе следующих append. Значение длиннее блока получает свой блок.
+    // views() годится как вход check_batch.
+    class string_pool {
+    public:
+        static constexpr std::size_t default_block = 1u << 16;
+
+        explicit string_pool(std::size_t block_size = default_block)
+                : block_size(std::max<std::size_t>(block_size, 1)) {}
+
+        // Место под items значений и блок на bytes байтов, если блоков ещё нет
+        void reserve(std::size_t bytes, std::size_t items) {
+            values.reserve(items);
+            if (blocks.empty() && bytes > 0) add_block(bytes);
+        }
+
+        // Копирует value в пул и возвращает его номер
+        std::size_t append(std::string_view value) {
+            if (value.empty()) {
+                values.emplace_back();
+            } else {
+                char *to = allocate(value.size());
+                std::memcpy(to, value.data(), value.size());
+                values.emplace_back(to, value.size());
+                total += value.size();
+            }
+            return values.size() - 1;
+        }
+
+        std::size_t size() const noexcept { return values.size(); }
+
+        bool empty() const noexcept { return values.empty(); }
+
+        // Действительно до reset
+        std::string_view operator[](std::size_t i) const noexcept { return values[i]; }
+
+        // Значения по порядку добавления
+        const std::vector<std::string_view> &views() const noexcept { return values; }
+
+        // Байтов во всех значениях
+        std::size_t bytes() const noexcept { return total; }
+
+        // Выделенных блоков, включая свободные после reset
+        std::size_t block_count() const noexcept { return blocks.size(); }
+
+        // Забывает все значения, блоки сохраняются
+        void reset() noexcept {
+            values.clear();
+            current = 0;
+            used = 0;
+            total = 0;
+        }
+
+    private:
+        struct block {
+            std::unique_ptr<char[]> data;
+            std::size_t capacity;
+        };
+
+        std::size_t block_size;
+        std::vector<block> blocks;
+        std::size_t current = 0; // блок, в который идёт запись
+        std::size_t used = 0;    // занято в текущем блоке
+        std::size_t total = 0;
+        std::vector<std::string_view> values;
+
+        void add_block(std::size_t at_least) {
+            const std::size_t capacity = std::max(at_least, block_size);
+            blocks.push_back({std::unique_ptr<char[]>(new char[capacity]), capacity});
+        }
+
+        // Значение не делится между блоками: если в текущем не хватает места,
+        // берётся следующий блок, в котором хватает, или новый
+        char *allocate(std::size_t size) {
+            for (; current < blocks.size(); ++current, used = 0) {
+                if (blocks[current].capacity - used >= size) {
+                    char *at = blocks[current].data.get() + used;
+                    used += size;
+                    return at;
+                }
+            }
+            add_block(size);
+            current = blocks.size() - 1;
+            used = size;
+            return blocks[current].data.get();
+        }
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_STRING_POOL_H
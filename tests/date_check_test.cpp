@@ -0,0 +1,269 @@
+// parse_date и parse_dates: календарь (високосные годы с правилом веков, длины
+// месяцев) против timegm, разделители dmy, время, дробная часть, смещения,
+// годы из двух цифр и столбец дат.
+
+#include "date_check.h"
+#include "batch_check.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define timegm _mkgmtime
+#endif
+
+namespace {
+
+    using inpch::check_error;
+    using inpch::date_format;
+
+    std::size_t failures = 0;
+
+    void fail(const std::string &input, const char *what) {
+        if (++failures <= 20) std::fprintf(stderr, "\"%s\": %s\n", input.c_str(), what);
+    }
+
+    void expect_ok(const std::string &input, date_format format) {
+        if (!inpch::is_date(input, format)) fail(input, "rejected");
+    }
+
+    void expect_error(const std::string &input, date_format format, check_error error, std::size_t position) {
+        inpch::date_result r = inpch::parse_date(input, format);
+        if (r.error != error || r.position != position) {
+            char what[64];
+            std::snprintf(what, sizeof(what), "error %d@%zu, expected %d@%zu", static_cast<int>(r.error),
+                          r.position, static_cast<int>(error), position);
+            fail(input, what);
+        }
+    }
+
+    // Секунды от эпохи по timegm; дата существует, если timegm её не нормализовал
+    bool reference(int year, int month, int day, int hour, int minute, int second, std::int64_t &seconds) {
+        std::tm tm{};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        tm.tm_min = minute;
+        tm.tm_sec = second;
+        seconds = static_cast<std::int64_t>(timegm(&tm));
+        return tm.tm_year == year - 1900 && tm.tm_mon == month - 1 && tm.tm_mday == day;
+    }
+
+    std::string two(unsigned n) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "%02u", n % 100);
+        return buffer;
+    }
+
+    std::string iso(int year, int month, int day) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+        return buffer;
+    }
+
+    // Все дни 0-32 каждого месяца: верные принимаются, остальные - out_of_range в дне
+    void calendar() {
+        const int years[] = {1600, 1700, 1800, 1900, 1970, 1999, 2000, 2023, 2024, 2100, 2400, 9999};
+        for (int year: years) {
+            for (int month = 1; month <= 12; ++month) {
+                for (int day = 0; day <= 32; ++day) {
+                    std::int64_t seconds;
+                    const bool exists = day >= 1 && reference(year, month, day, 0, 0, 0, seconds);
+                    const std::string date = iso(year, month, day);
+                    inpch::date_result r = inpch::parse_date(date, date_format::iso_date);
+                    if (exists != static_cast<bool>(r)) {
+                        fail(date, "calendar differs from timegm");
+                    } else if (exists && r.value.epoch_seconds() != seconds) {
+                        fail(date, "epoch_seconds differs from timegm");
+                    } else if (!exists && (r.error != check_error::out_of_range || r.position != 8)) {
+                        fail(date, "wrong error for a missing day");
+                    }
+
+                    const std::string dmy = two(day) + "." + two(month) + "." + std::to_string(year);
+                    if (exists != inpch::is_date(dmy, date_format::dmy)) fail(dmy, "dmy calendar differs");
+                }
+            }
+        }
+        // Правило веков
+        expect_ok("2000-02-29", date_format::iso_date);
+        expect_ok("2400-02-29", date_format::iso_date);
+        expect_error("1900-02-29", date_format::iso_date, check_error::out_of_range, 8);
+        expect_error("2100-02-29", date_format::iso_date, check_error::out_of_range, 8);
+        expect_error("2023-02-29", date_format::iso_date, check_error::out_of_range, 8);
+        expect_error("2023-13-01", date_format::iso_date, check_error::out_of_range, 5);
+        expect_error("2023-00-01", date_format::iso_date, check_error::out_of_range, 5);
+    }
+
+    // Случайные дата и время со смещением против timegm
+    void epoch_seconds() {
+        std::mt19937 rng(15);
+        for (int i = 0; i < 100000; ++i) {
+            const int year = 1600 + static_cast<int>(rng() % 800);
+            const int month = 1 + static_cast<int>(rng() % 12);
+            const int day = 1 + static_cast<int>(rng() % inpch::days_in_month(year, static_cast<unsigned>(month)));
+            const int hour = static_cast<int>(rng() % 24), minute = static_cast<int>(rng() % 60);
+            const int second = static_cast<int>(rng() % 60);
+            const int offset = static_cast<int>(rng() % (28 * 4 + 1)) * 15 - 14 * 60;
+
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d%c%02d:%02d", year, month, day, hour,
+                          minute, second, offset < 0 ? '-' : '+', std::abs(offset) / 60, std::abs(offset) % 60);
+            std::int64_t seconds;
+            reference(year, month, day, hour, minute, second, seconds);
+            inpch::date_result r = inpch::parse_date(buffer, date_format::iso_datetime);
+            if (!r) {
+                fail(buffer, "rejected");
+            } else if (r.value.epoch_seconds() != seconds - offset * 60 || r.value.offset_minutes != offset) {
+                fail(buffer, "epoch_seconds differs from timegm");
+            }
+        }
+    }
+
+    void separators() {
+        for (const char *date: {"01.02.2023", "1.2.2023", "01/02/2023", "1/2/2023", "01-02-2023", "1-2-2023"}) {
+            expect_ok(date, date_format::dmy);
+            expect_ok(date, date_format::any);
+        }
+        expect_ok("01.02.2023", date_format::dmy_dot);
+        expect_ok("01/02/2023", date_format::dmy_slash);
+        expect_ok("01-02-2023", date_format::dmy_dash);
+        expect_error("01/02/2023", date_format::dmy_dot, check_error::wrong_character, 2);
+        expect_error("01.02.2023", date_format::dmy_slash, check_error::wrong_character, 2);
+        expect_error("01.02.2023", date_format::dmy_dash, check_error::wrong_character, 2);
+
+        // Разделители должны совпадать
+        expect_error("01.02/2023", date_format::dmy, check_error::wrong_character, 5);
+        expect_error("01/02-2023", date_format::dmy, check_error::wrong_character, 5);
+        expect_error("1-2.2023", date_format::any, check_error::wrong_character, 3);
+        expect_error("01,02,2023", date_format::dmy, check_error::wrong_character, 2);
+        expect_error("01.", date_format::dmy, check_error::wrong_length, 3);
+        expect_error("01", date_format::dmy, check_error::wrong_length, 2);
+        expect_error("2023/02/01", date_format::any, check_error::wrong_character, 4);
+    }
+
+    void two_digit_years() {
+        auto year_of = [](const char *input) {
+            inpch::date_result r = inpch::parse_date(input, date_format::dmy);
+            return r ? r.value.year : -1;
+        };
+        if (year_of("01.02.68") != 2068) fail("01.02.68", "expected 2068");
+        if (year_of("01.02.69") != 1969) fail("01.02.69", "expected 1969");
+        if (year_of("01.02.99") != 1999) fail("01.02.99", "expected 1999");
+        if (year_of("01.02.00") != 2000) fail("01.02.00", "expected 2000");
+        if (year_of("1/2/23") != 2023) fail("1/2/23", "expected 2023");
+        expect_ok("29.02.00", date_format::dmy);
+        expect_ok("29-02-96", date_format::dmy_dash);
+        expect_error("29.02.01", date_format::dmy, check_error::out_of_range, 0);
+        expect_error("29.02.1900", date_format::dmy, check_error::out_of_range, 0);
+        expect_error("01.02.202", date_format::dmy, check_error::wrong_length, 9);
+        expect_error("01.02.2", date_format::dmy, check_error::wrong_length, 7);
+        expect_error("01.02.20231", date_format::dmy, check_error::wrong_character, 10);
+    }
+
+    void times() {
+        for (const char *t: {"2024-01-02T03:04", "2024-01-02t03:04", "2024-01-02 03:04", "2024-01-02T23:59:59Z",
+                             "2024-01-02 00:00:00.5z", "2024-01-02T12:00+03:00", "2024-01-02T12:00-0530"}) {
+            expect_ok(t, date_format::iso_datetime);
+            expect_ok(t, date_format::iso);
+            expect_ok(t, date_format::any);
+        }
+        expect_error("2024-01-02_03:04", date_format::iso, check_error::wrong_character, 10);
+        expect_error("2024-01-02  03:04", date_format::iso, check_error::wrong_character, 11);
+        expect_error("2024-01-02T03:04", date_format::iso_date, check_error::wrong_character, 10);
+        expect_error("2024-01-02", date_format::iso_datetime, check_error::wrong_length, 10);
+        expect_error("2024-01-02T", date_format::iso, check_error::wrong_length, 11);
+        expect_error("2024-01-02T24:00", date_format::iso, check_error::out_of_range, 11);
+        expect_error("2024-01-02T23:60", date_format::iso, check_error::out_of_range, 14);
+        expect_error("2024-01-02T23:59:60", date_format::iso, check_error::out_of_range, 17);
+        expect_error("2024-01-02T23:59:59.", date_format::iso, check_error::wrong_length, 20);
+
+        // Дробная часть: учитываются первые девять цифр, остальные пропускаются
+        struct fraction_case {
+            const char *input;
+            std::uint32_t nanosecond;
+        };
+        const fraction_case fractions[] = {
+                {"2024-01-02T03:04:05.1", 100000000},
+                {"2024-01-02T03:04:05,25", 250000000},
+                {"2024-01-02T03:04:05.123456789", 123456789},
+                {"2024-01-02T03:04:05.1234567891", 123456789},
+                {"2024-01-02T03:04:05.999999999999999999Z", 999999999},
+                {"2024-01-02T03:04:05.000000001+01:00", 1},
+        };
+        for (const auto &f: fractions) {
+            inpch::date_result r = inpch::parse_date(f.input, date_format::iso);
+            if (!r || r.value.nanosecond != f.nanosecond) fail(f.input, "wrong nanosecond");
+        }
+
+        // Смещения не больше ±14:00
+        expect_ok("2024-01-02T03:04+14:00", date_format::iso);
+        expect_ok("2024-01-02T03:04-14:00", date_format::iso);
+        expect_ok("2024-01-02T03:04+13:59", date_format::iso);
+        expect_ok("2024-01-02T03:04-1200", date_format::iso);
+        expect_error("2024-01-02T03:04+14:01", date_format::iso, check_error::out_of_range, 20);
+        expect_error("2024-01-02T03:04-1430", date_format::iso, check_error::out_of_range, 19);
+        expect_error("2024-01-02T03:04+15:00", date_format::iso, check_error::out_of_range, 17);
+        expect_error("2024-01-02T03:04-23:59", date_format::iso, check_error::out_of_range, 17);
+        expect_error("2024-01-02T03:04+05:60", date_format::iso, check_error::out_of_range, 20);
+        expect_error("2024-01-02T03:04+5", date_format::iso, check_error::wrong_length, 18);
+        expect_error("2024-01-02T03:04+5x", date_format::iso, check_error::wrong_character, 18);
+        expect_error("2024-01-02T03:04+05:", date_format::iso, check_error::wrong_length, 20);
+    }
+
+    // Столбец против parse_date по элементам: в вызывающем потоке и в пуле
+    void batch() {
+        std::mt19937 rng(24);
+        const char *samples[] = {"2024-02-29", "2023-02-29", "2024-01-02T03:04:05+01:00", "31.12.1999", "31.11.1999",
+                                 "1/2/03", "", "2024-1-02", "2024-01-02 03:04:05.5Z", "x"};
+        for (std::size_t count: {std::size_t(1), std::size_t(130), std::size_t(40000)}) {
+            std::vector<std::string> values(count);
+            for (auto &v: values) v = samples[rng() % std::size(samples)];
+            std::vector<std::string_view> column(values.begin(), values.end());
+            std::string bytes;
+            std::vector<std::size_t> offsets{0};
+            for (const auto &v: values) {
+                bytes += v;
+                offsets.push_back(bytes.size());
+            }
+
+            inpch::batch_options options;
+            options.parallel_threshold = 64;
+            options.chunk_size = 128;
+            std::vector<std::int64_t> seconds(count, -1), packed(count, -1);
+            const inpch::result_bitmap bits = inpch::parse_dates(column, date_format::any, seconds.data(), options);
+            const inpch::result_bitmap packed_bits =
+                    inpch::parse_dates(bytes.data(), offsets.data(), count, date_format::any, packed.data());
+            const inpch::result_bitmap check_only = inpch::parse_dates(column, date_format::any, nullptr, options);
+            for (std::size_t i = 0; i < count; ++i) {
+                inpch::date_result r = inpch::parse_date(column[i], date_format::any);
+                const std::int64_t want = r ? r.value.epoch_seconds() : 0;
+                if (bits[i] != static_cast<bool>(r) || packed_bits[i] != bits[i] || check_only[i] != bits[i] ||
+                    seconds[i] != want || packed[i] != want) {
+                    fail(values[i], "parse_dates differs from parse_date");
+                    break;
+                }
+            }
+        }
+    }
+
+} // namespace
+
+int main() {
+    calendar();
+    epoch_seconds();
+    separators();
+    two_digit_years();
+    times();
+    batch();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "date_check_test: %zu failures\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// rgxp::dfa против std::regex_match на тех же текстах шаблонов: верные примеры,
+// их случайные искажения и случайные строки из символов шаблона.
+
+#include "input_check.h"
+
+#include <cstdio>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct pattern_case {
+        const inpch::regex_pattern &regex;
+        const inpch::dfa_pattern &automaton;
+        std::vector<std::string> samples; // верные примеры - основа для искажений
+        const char *alphabet;
+    };
+
+    std::string mutate(std::string s, std::mt19937 &rng, const std::string &alphabet) {
+        for (std::size_t n = rng() % 3 + 1; n > 0; --n) {
+            const char ch = alphabet[rng() % alphabet.size()];
+            const std::size_t at = s.empty() ? 0 : rng() % s.size();
+            switch (rng() % 3) {
+                case 0:
+                    s.insert(at, 1, ch);
+                    break;
+                case 1:
+                    if (!s.empty()) s.erase(at, 1);
+                    break;
+                default:
+                    if (!s.empty()) s[at] = ch;
+            }
+        }
+        return s;
+    }
+
+} // namespace
+
+int main() {
+    const pattern_case cases[] = {
+            {rgxp::number, rgxp::dfa::number, {"0", "12345", "007"}, "0123456789a -+"},
+            {rgxp::email, rgxp::dfa::email, {"a.b@c.de", "user+tag@mail-host.org", "x_%@1.io"},
+             "aZ09._%+-@.com"},
+            {rgxp::url, rgxp::dfa::url, {"http://ab.cd", "https://www.example.com", "http://a@b:c.de"},
+             "htps:/w.exampl-@%_+~#=09"},
+            {rgxp::phone_number, rgxp::dfa::phone_number, {"+7 (912) 345-67-89", "8.800.555.35.35", "12345"},
+             "+0123456789()-. \t"},
+            {rgxp::hex, rgxp::dfa::hex, {"#a0f", "#00ff99", "abc"}, "#0af9gA"},
+            {rgxp::date_YYYY_MM_DD, rgxp::dfa::date_YYYY_MM_DD, {"2024-02-29", "1999-12-31", "0000-01-01"},
+             "0123456789-/"},
+    };
+
+    std::mt19937 rng(15);
+    std::size_t failures = 0;
+    for (const pattern_case &c: cases) {
+        const std::regex &regex = c.regex.get();
+        const inpch::dfa &automaton = c.automaton.get();
+        const std::string alphabet = c.alphabet;
+        for (int i = 0; i < 20000; ++i) {
+            std::string input;
+            if (i % 4 == 0) {
+                for (std::size_t n = rng() % 16; n > 0; --n) input += alphabet[rng() % alphabet.size()];
+            } else {
+                input = mutate(c.samples[rng() % c.samples.size()], rng, alphabet);
+            }
+            const bool want = std::regex_match(input, regex);
+            if (automaton.match(input) != want && ++failures <= 10) {
+                std::fprintf(stderr, "%s \"%s\": dfa %d, std::regex %d\n", c.automaton.pattern(), input.c_str(),
+                             !want, want);
+            }
+        }
+        for (const std::string &sample: c.samples) {
+            if (!automaton.match(sample) && ++failures <= 10) {
+                std::fprintf(stderr, "%s rejects sample \"%s\"\n", c.automaton.pattern(), sample.c_str());
+            }
+        }
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "dfa_test: %zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
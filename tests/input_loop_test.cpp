@@ -0,0 +1,336 @@
+// basic_line_reader и read_valid_lines на канале с неблокирующим концом чтения:
+// писатель отдаёт строки кусками случайной длины с паузами и закрывает канал
+// посреди строки. Строки и счётчики сверяются с циклом std::getline.
+// Там же - string_pool, в который read_valid_lines и validation_pipeline
+// складывают принятые строки: рост блоками, reset и неизменность представлений.
+
+#include "input_loop.h"
+#include "string_pool.h"
+#include "validation_pipeline.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+int main() {
+    std::puts("input_loop_test: POSIX pipes are not available, skipped");
+    return 0;
+}
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+    std::size_t failures = 0;
+
+    void expect(bool ok, const std::string &what) {
+        if (!ok && ++failures <= 20) std::fprintf(stderr, "%s\n", what.c_str());
+    }
+
+    // Строки из цифр, иногда с посторонним символом, пустые и с "\r\n"; в конце -
+    // строка без '\n'
+    std::string make_text(std::mt19937 &rng, std::size_t lines) {
+        std::string text;
+        for (std::size_t i = 0; i < lines; ++i) {
+            const std::size_t length = rng() % 8 == 0 ? rng() % 300 : rng() % 20;
+            for (std::size_t k = 0; k < length; ++k) text += "0123456789"[rng() % 10];
+            if (length > 0 && rng() % 5 == 0) text[text.size() - 1 - rng() % length] = 'x';
+            text += rng() % 6 == 0 ? "\r\n" : "\n";
+        }
+        text += "12345x67";
+        return text;
+    }
+
+    std::vector<std::string> getline_lines(const std::string &text) {
+        std::istringstream in(text);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    // Канал: конец чтения неблокирующий, писатель пишет кусками в своём потоке
+    struct pipe_writer {
+        int read_fd = -1;
+        std::thread writer;
+
+        pipe_writer(const std::string &text, std::uint32_t seed, std::chrono::milliseconds delay_start = {}) {
+            int fds[2];
+            if (::pipe(fds) != 0) {
+                std::perror("pipe");
+                std::exit(2);
+            }
+            read_fd = fds[0];
+            ::fcntl(read_fd, F_SETFL, ::fcntl(read_fd, F_GETFL) | O_NONBLOCK);
+            const int write_fd = fds[1];
+            writer = std::thread([text, seed, write_fd, delay_start] {
+                std::this_thread::sleep_for(delay_start);
+                std::mt19937 rng(seed);
+                std::size_t at = 0;
+                while (at < text.size()) {
+                    const std::size_t size = std::min<std::size_t>(1 + rng() % 97, text.size() - at);
+                    const ssize_t written = ::write(write_fd, text.data() + at, size);
+                    if (written < 0 && errno == EINTR) continue;
+                    if (written < 0) break;
+                    at += static_cast<std::size_t>(written);
+                    if (rng() % 16 == 0) std::this_thread::sleep_for(std::chrono::microseconds(500));
+                }
+                ::close(write_fd);
+            });
+        }
+
+        // Если читатель остановился раньше, писатель получает EPIPE и не зависает
+        ~pipe_writer() {
+            ::close(read_fd);
+            writer.join();
+        }
+    };
+
+    void lines_from_pipe(std::uint32_t seed, std::size_t buffer_size) {
+        std::mt19937 rng(seed);
+        const std::string text = make_text(rng, 2000);
+        const std::vector<std::string> want = getline_lines(text);
+
+        pipe_writer pipe(text, seed);
+        inpch::line_reader reader(pipe.read_fd, buffer_size);
+        std::vector<std::string> got;
+        std::string_view line;
+        inpch::read_status status;
+        while ((status = reader.next(line)) == inpch::read_status::line) got.emplace_back(line);
+
+        expect(status == inpch::read_status::eof, "next does not end with eof");
+        expect(got == want, "next: lines differ from std::getline, buffer " + std::to_string(buffer_size));
+        expect(reader.line_number() == want.size(), "line_number");
+        expect(reader.next(line) == inpch::read_status::eof, "eof is not sticky");
+    }
+
+    void bulk_from_pipe(std::uint32_t seed, std::size_t buffer_size) {
+        std::mt19937 rng(seed);
+        const std::string text = make_text(rng, 3000);
+        const std::vector<std::string> lines = getline_lines(text);
+        const inpch::check_spec spec(inpch::any_length, inpch::decimal);
+        std::vector<std::string> accepted;
+        std::uint64_t rejected = 0;
+        for (const auto &line: lines) {
+            if (spec(line)) {
+                accepted.push_back(line);
+            } else {
+                ++rejected;
+            }
+        }
+
+        pipe_writer pipe(text, seed + 1);
+        inpch::line_reader reader(pipe.read_fd, buffer_size);
+        inpch::bulk_options options;
+        // Пакеты меньше порога тоже идут в пул, чтобы проверить и этот путь
+        options.batch.parallel_threshold = 64;
+        options.batch.chunk_size = 64;
+        const inpch::bulk_result result = inpch::read_valid_lines(reader, spec, options);
+
+        const std::string where = ", buffer " + std::to_string(buffer_size);
+        expect(result.status == inpch::loop_status::eof, "read_valid_lines status" + where);
+        expect(result.lines == lines.size(), "read_valid_lines line count" + where);
+        expect(result.rejected == rejected, "read_valid_lines rejected count" + where);
+        expect(result.values == accepted, "read_valid_lines values" + where);
+    }
+
+    // Данных нет дольше timeout_ms: timeout, после чего чтение продолжается
+    void timeout() {
+        const std::string text = "1\n22\n333";
+        pipe_writer pipe(text, 5, std::chrono::milliseconds(200));
+        inpch::line_reader reader(pipe.read_fd);
+        std::string_view line;
+        expect(reader.next(line, 10) == inpch::read_status::timeout, "no timeout on a silent pipe");
+        std::vector<std::string> got;
+        inpch::read_status status;
+        while ((status = reader.next(line, 5000)) == inpch::read_status::line) got.emplace_back(line);
+        expect(status == inpch::read_status::eof && got == std::vector<std::string>{"1", "22", "333"},
+               "lines after timeout");
+
+        inpch::loop_options options;
+        options.timeout_ms = 10;
+        pipe_writer silent("", 6, std::chrono::milliseconds(200));
+        inpch::line_reader silent_reader(silent.read_fd);
+        expect(inpch::input_loop(silent_reader, inpch::check_spec(), options).status == inpch::loop_status::timeout,
+               "input_loop timeout");
+    }
+
+    void read_error() {
+        inpch::line_reader reader(-1);
+        std::string_view line;
+        expect(reader.next(line) == inpch::read_status::error && reader.error_code() == EBADF, "error on a bad fd");
+        inpch::line_reader bulk_reader(-1);
+        expect(inpch::read_valid_lines(bulk_reader, inpch::check_spec()).status == inpch::loop_status::error,
+               "read_valid_lines error");
+    }
+
+    // Тот же разбор из потока, узкого и широкого
+    void streams() {
+        std::mt19937 rng(9);
+        const std::string text = make_text(rng, 500);
+        std::istringstream in(text);
+        inpch::line_reader reader(in, 64);
+        std::vector<std::string> got;
+        std::string_view line;
+        while (reader.next(line) == inpch::read_status::line) got.emplace_back(line);
+        expect(got == getline_lines(text), "stream: lines differ from std::getline");
+
+        std::wistringstream win(L"один\r\nдва\n\nтри");
+        inpch::wline_reader wreader(win, 64);
+        std::vector<std::wstring> wgot;
+        std::wstring_view wline;
+        while (wreader.next(wline) == inpch::read_status::line) wgot.emplace_back(wline);
+        expect(wgot == std::vector<std::wstring>{L"один", L"два", L"", L"три"}, "wide stream lines");
+    }
+
+    std::string random_value(std::mt19937 &rng, std::size_t max_length) {
+        std::string value(rng() % (max_length + 1), '0');
+        for (char &ch: value) ch = "0123456789x"[rng() % 11];
+        return value;
+    }
+
+    // Значение длиннее блока получает свой блок, следующее идёт в новый обычный
+    void pool_blocks() {
+        inpch::string_pool pool(16);
+        expect(pool.empty() && pool.block_count() == 0, "new pool is not empty");
+        pool.append("abc");
+        const std::string large(40, 'L');
+        pool.append(large);
+        expect(pool.block_count() == 2 && pool[1] == large, "value larger than a block");
+        pool.append("0123456789abc");
+        expect(pool.block_count() == 3, "block after a large value");
+        pool.append("");
+        expect(pool.size() == 4 && pool[3].empty() && pool.bytes() == 3 + 40 + 13, "empty value");
+        expect(pool[0] == "abc" && pool[2] == "0123456789abc", "values after growth");
+    }
+
+    // Представления не меняются при любом числе следующих append; после reset
+    // тот же набор значений помещается в уже выделенные блоки
+    void pool_views_and_reset() {
+        std::mt19937 rng(17);
+        std::vector<std::string> values;
+        for (std::size_t i = 0; i < 20000; ++i) values.push_back(random_value(rng, i % 100 == 0 ? 3000 : 40));
+
+        inpch::string_pool pool(1024);
+        std::vector<std::string_view> held;
+        std::size_t bytes = 0;
+        for (const auto &value: values) {
+            held.push_back(pool[pool.append(value)]);
+            bytes += value.size();
+        }
+        bool same = held.size() == pool.size();
+        for (std::size_t i = 0; same && i < values.size(); ++i) {
+            same = held[i] == values[i] && held[i].data() == pool[i].data() && pool.views()[i] == values[i];
+        }
+        expect(same, "views changed after more appends");
+        expect(pool.bytes() == bytes, "bytes");
+
+        const std::size_t blocks = pool.block_count();
+        pool.reset();
+        expect(pool.empty() && pool.size() == 0 && pool.bytes() == 0 && pool.block_count() == blocks, "reset");
+        for (std::size_t round = 0; round < 3; ++round) {
+            pool.reset();
+            for (const auto &value: values) pool.append(value);
+        }
+        same = pool.size() == values.size();
+        for (std::size_t i = 0; same && i < values.size(); ++i) same = pool[i] == values[i];
+        expect(same && pool.block_count() == blocks, "reuse after reset allocates blocks");
+
+        // views() подаётся в check_batch как есть
+        const inpch::check_spec spec(inpch::any_length, inpch::decimal);
+        std::size_t accepted = 0;
+        for (const auto &value: values) accepted += spec(value);
+        expect(inpch::check_batch(pool.views(), spec).count() == accepted, "check_batch over views()");
+    }
+
+    // read_valid_lines складывает принятые строки в пул; строки первых блоков
+    // остаются целыми до конца чтения
+    void bulk_into_pool(std::size_t buffer_size) {
+        std::mt19937 rng(23);
+        const std::string text = make_text(rng, 3000);
+        const inpch::check_spec spec(inpch::any_length, inpch::decimal);
+        std::vector<std::string> accepted;
+        for (const auto &line: getline_lines(text)) {
+            if (spec(line)) accepted.push_back(line);
+        }
+
+        pipe_writer pipe(text, 24);
+        inpch::line_reader reader(pipe.read_fd, buffer_size);
+        inpch::string_pool pool(256);
+        inpch::bulk_options options;
+        options.batch.accepted = &pool;
+        const inpch::bulk_result result = inpch::read_valid_lines(reader, spec, options);
+        expect(result.status == inpch::loop_status::eof && result.values.empty(), "read_valid_lines into a pool");
+        expect(pool.views() == std::vector<std::string_view>(accepted.begin(), accepted.end()),
+               "pool lines differ from std::getline, buffer " + std::to_string(buffer_size));
+    }
+
+    // Представления из pop_accepted(string_pool &) переживают следующие вызовы,
+    // хотя пакеты конвейера к тому времени заполнены другими элементами
+    void pipeline_into_pool() {
+        std::mt19937 rng(31);
+        std::vector<std::string> inputs;
+        for (std::size_t i = 0; i < 5000; ++i) inputs.push_back(random_value(rng, 12));
+        const inpch::check_spec spec(inpch::any_length, inpch::decimal);
+
+        inpch::validation_pipeline pipeline(spec, {2, 32, 4});
+        std::thread pusher([&] {
+            for (const auto &s: inputs) pipeline.push(s);
+            pipeline.close();
+        });
+        inpch::string_pool pool(64);
+        std::vector<std::string_view> held;
+        while (pipeline.pop_accepted(pool)) {
+            for (std::size_t i = held.size(); i < pool.size(); ++i) held.push_back(pool[i]);
+        }
+        pusher.join();
+
+        std::vector<std::string_view> want;
+        for (const auto &s: inputs) {
+            if (spec(s)) want.emplace_back(s);
+        }
+        expect(held == want, "pop_accepted views changed after later batches");
+    }
+
+} // namespace
+
+int main() {
+    std::signal(SIGPIPE, SIG_IGN);
+    // Маленький буфер: строки переходят через границы чтения, длинные строки
+    // увеличивают буфер
+    for (std::size_t buffer_size: {std::size_t(64), std::size_t(100), inpch::line_reader::default_buffer}) {
+        lines_from_pipe(static_cast<std::uint32_t>(buffer_size), buffer_size);
+        bulk_from_pipe(static_cast<std::uint32_t>(buffer_size), buffer_size);
+    }
+    timeout();
+    read_error();
+    streams();
+    pool_blocks();
+    pool_views_and_reset();
+    bulk_into_pool(64);
+    bulk_into_pool(inpch::line_reader::default_buffer);
+    pipeline_into_pool();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "input_loop_test: %zu failures\n", failures);
+        return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,121 @@
+// parse_number против strtoll/strtoull: значение, вид ошибки и позиция
+// недопустимого символа для всех оснований и нескольких целых типов.
+
+#include "number_parse.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace {
+
+    std::size_t failures = 0;
+
+    bool is_digit(char ch, int radix) {
+        if (ch >= '0' && ch <= '9') return ch - '0' < radix;
+        if (ch >= 'a' && ch <= 'f') return radix == 16;
+        if (ch >= 'A' && ch <= 'F') return radix == 16;
+        return false;
+    }
+
+    // Ожидаемый результат: строку проверяем сами (strtoll пропускает пробелы и
+    // принимает 0x), значение и переполнение берём у strtoll/strtoull
+    template<class Int>
+    inpch::parse_result<Int> reference(const std::string &input, int radix) {
+        if (input.empty()) return {Int{}, inpch::parse_error::empty, 0};
+        const bool sign = radix == 10 && (input[0] == '+' || input[0] == '-');
+        if (sign && input.size() == 1) return {Int{}, inpch::parse_error::invalid_character, 1};
+        for (std::size_t i = sign; i < input.size(); ++i) {
+            if (!is_digit(input[i], radix)) return {Int{}, inpch::parse_error::invalid_character, i};
+        }
+
+        errno = 0;
+        bool overflow;
+        Int value{};
+        if constexpr (std::is_signed<Int>::value) {
+            const long long v = std::strtoll(input.c_str(), nullptr, radix);
+            overflow = errno == ERANGE || v < std::numeric_limits<Int>::min() || v > std::numeric_limits<Int>::max();
+            value = static_cast<Int>(v);
+        } else {
+            const bool negative = input[0] == '-';
+            const unsigned long long v = std::strtoull(input.c_str() + negative, nullptr, radix);
+            overflow = errno == ERANGE || v > std::numeric_limits<Int>::max() || (negative && v != 0);
+            value = static_cast<Int>(v);
+        }
+        if (overflow) return {Int{}, inpch::parse_error::overflow, 0};
+        return {value, inpch::parse_error::none, input.size()};
+    }
+
+    template<class Int>
+    void compare(const char *type, const std::string &input, inpch::base_type base) {
+        const auto got = inpch::parse_number<Int>(input, base);
+        const auto want = reference<Int>(input, static_cast<int>(base));
+        bool same = got.error == want.error;
+        if (same && want.error == inpch::parse_error::none) same = got.value == want.value;
+        if (same && want.error == inpch::parse_error::invalid_character) same = got.position == want.position;
+        if (!same && ++failures <= 10) {
+            std::fprintf(stderr, "%s base %d \"%s\": error %d@%zu, expected %d@%zu\n", type, static_cast<int>(base),
+                         input.c_str(), static_cast<int>(got.error), got.position, static_cast<int>(want.error),
+                         want.position);
+        }
+    }
+
+    std::string random_number(std::mt19937 &rng, const std::string &digits) {
+        std::string s;
+        switch (rng() % 4) {
+            case 0:
+                s += '-';
+                break;
+            case 1:
+                s += '+';
+                break;
+            default:
+                break;
+        }
+        // Ведущие нули и длины около границы типа
+        for (std::size_t n = rng() % 12 == 0 ? rng() % 10 : 0; n > 0; --n) s += '0';
+        for (std::size_t n = rng() % 70; n > 0; --n) s += digits[rng() % digits.size()];
+        if (rng() % 6 == 0 && !s.empty()) s[rng() % s.size()] = " x9fg-"[rng() % 6];
+        return s;
+    }
+
+} // namespace
+
+int main() {
+    using namespace inpch;
+    std::mt19937 rng(10);
+    const base_type bases[] = {decimal, octal, hexadecimal, binary};
+    const char *digits[] = {"0123456789", "01234567", "0123456789abcdefABCDEF", "01"};
+    for (int b = 0; b < 4; ++b) {
+        const std::string alphabet = digits[b];
+        for (int i = 0; i < 50000; ++i) {
+            std::string input = random_number(rng, alphabet);
+            // Длина, при которой значение около предела 64 бит
+            if (i % 2) input.resize(std::min<std::size_t>(input.size(), b == 3 ? 66 : b == 2 ? 18 : 24));
+            compare<long long>("long long", input, bases[b]);
+            compare<unsigned long long>("unsigned long long", input, bases[b]);
+            compare<int>("int", input, bases[b]);
+            compare<unsigned short>("unsigned short", input, bases[b]);
+        }
+    }
+
+    // Границы типов
+    const char *edges[] = {"9223372036854775807", "9223372036854775808", "-9223372036854775808",
+                           "-9223372036854775809", "18446744073709551615", "18446744073709551616",
+                           "2147483647", "2147483648", "-2147483648", "-2147483649", "65535", "65536", "-0",
+                           "000000000000000000000000009223372036854775807"};
+    for (const char *edge: edges) {
+        compare<long long>("long long", edge, decimal);
+        compare<unsigned long long>("unsigned long long", edge, decimal);
+        compare<int>("int", edge, decimal);
+        compare<unsigned short>("unsigned short", edge, decimal);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "number_parse_test: %zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+// validation_pipeline: порядок и вердикты pop для разных потоков, размеров пакетов
+// и числа пакетов в обработке, pop_accepted в обоих видах, close с элементами в
+// обработке и разрушение без чтения результатов.
+
+#include "validation_pipeline.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    std::size_t failures = 0;
+
+    void expect(bool ok, const char *what, const inpch::pipeline_options &options) {
+        if (ok) return;
+        if (++failures <= 10) {
+            std::fprintf(stderr, "%s: workers %zu, batch %zu, in flight %zu\n", what, options.workers,
+                         options.batch_size, options.batches_in_flight);
+        }
+    }
+
+    std::vector<std::string> make_inputs(std::size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::string> out(count);
+        for (auto &s: out) {
+            for (std::size_t k = rng() % 12; k > 0; --k) s += "0123456789x"[rng() % (rng() % 3 ? 10 : 11)];
+        }
+        return out;
+    }
+
+    // Подающий поток: всё подаёт и закрывает вход
+    std::thread feed(inpch::validation_pipeline &pipeline, const std::vector<std::string> &inputs) {
+        return std::thread([&pipeline, &inputs] {
+            for (const auto &s: inputs) pipeline.push(s);
+            pipeline.close();
+        });
+    }
+
+} // namespace
+
+int main() {
+    using namespace inpch;
+    const check_spec spec(any_length, decimal);
+
+    for (std::size_t workers: {1, 2, 4}) {
+        for (std::size_t batch_size: {1, 3, 64, 256}) {
+            for (std::size_t in_flight: {0, 2, 5}) {
+                const pipeline_options options{workers, batch_size, in_flight};
+                const auto inputs = make_inputs(2000 + workers * 7 + batch_size, static_cast<std::uint32_t>(
+                        workers * 1000 + batch_size * 10 + in_flight));
+
+                {
+                    validation_pipeline pipeline(spec, options);
+                    std::thread pusher = feed(pipeline, inputs);
+                    std::uint64_t next = 0;
+                    bool ordered = true, correct = true;
+                    verdict v{};
+                    while (pipeline.pop(v)) {
+                        ordered = ordered && v.index == next;
+                        correct = correct && v.index < inputs.size() && v.accepted == spec(inputs[v.index]);
+                        ++next;
+                    }
+                    pusher.join();
+                    expect(ordered && next == inputs.size(), "pop order", options);
+                    expect(correct, "pop verdict", options);
+                    expect(!pipeline.pop(v), "pop after the end", options);
+                }
+
+                {
+                    validation_pipeline pipeline(spec, options);
+                    std::thread pusher = feed(pipeline, inputs);
+                    std::vector<std::uint64_t> want;
+                    for (std::size_t i = 0; i < inputs.size(); ++i) {
+                        if (spec(inputs[i])) want.push_back(i);
+                    }
+                    std::vector<std::uint64_t> got;
+                    bool same_items = true;
+                    std::string_view item;
+                    std::uint64_t index = 0;
+                    while (pipeline.pop_accepted(item, &index)) {
+                        got.push_back(index);
+                        same_items = same_items && index < inputs.size() && item == inputs[index];
+                    }
+                    pusher.join();
+                    expect(got == want && same_items, "pop_accepted", options);
+                }
+
+                {
+                    validation_pipeline pipeline(spec, options);
+                    std::thread pusher = feed(pipeline, inputs);
+                    string_pool pool;
+                    while (pipeline.pop_accepted(pool)) {}
+                    pusher.join();
+                    std::size_t at = 0;
+                    bool same = true;
+                    for (const auto &s: inputs) {
+                        if (!spec(s)) continue;
+                        same = same && at < pool.size() && pool[at] == s;
+                        ++at;
+                    }
+                    expect(same && at == pool.size(), "pop_accepted into string_pool", options);
+                }
+            }
+        }
+    }
+
+    // close отдаёт неполный пакет: все элементы доходят до читателя
+    {
+        const pipeline_options options{2, 64, 4};
+        validation_pipeline pipeline(spec, options);
+        const auto inputs = make_inputs(10, 3);
+        for (const auto &s: inputs) pipeline.push(s);
+        pipeline.close();
+        pipeline.close();
+        std::size_t count = 0;
+        verdict v{};
+        while (pipeline.pop(v)) count += v.index == count && v.accepted == spec(inputs[v.index]);
+        expect(count == inputs.size(), "close with a partial batch", options);
+    }
+
+    // Пустой вход
+    {
+        const pipeline_options options{3, 8, 0};
+        validation_pipeline pipeline(spec, options);
+        pipeline.close();
+        verdict v{};
+        string_pool pool;
+        expect(!pipeline.pop(v) && !pipeline.pop_accepted(pool), "empty input", options);
+    }
+
+    // Все пакеты заняты и никто не читает: try_push отказывает, а не ждёт,
+    // и уже поданные элементы не теряются
+    {
+        const pipeline_options options{2, 1, 2};
+        validation_pipeline pipeline(spec, options);
+        std::size_t pushed = 0;
+        while (pushed < 100 && pipeline.try_push("1")) ++pushed;
+        expect(pushed > 0 && pushed < 100, "try_push when full", options);
+        pipeline.close();
+        std::size_t count = 0;
+        verdict v{};
+        while (pipeline.pop(v)) count += v.index == count && v.accepted;
+        expect(count == pushed, "results after try_push", options);
+    }
+
+    // Разрушение с элементами в обработке и непрочитанными результатами не зависает
+    for (std::size_t workers: {1, 3}) {
+        const pipeline_options options{workers, 4, 3};
+        validation_pipeline pipeline(spec, options);
+        for (int i = 0; i < 10; ++i) pipeline.push("123");
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "pipeline_test: %zu failures\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+// record_schema: языковые поля против check_language, пустые обязательные и
+// необязательные поля, короткие и длинные строки, split_fields с ограниченной
+// ёмкостью и accepts_line при неверном числе полей.
+
+#include "record_schema.h"
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using inpch::field_mask;
+    using inpch::field_rule;
+    using inpch::record_schema;
+
+    std::size_t failures = 0;
+
+    void expect(bool ok, const std::string &what) {
+        if (!ok && ++failures <= 20) std::fprintf(stderr, "%s\n", what.c_str());
+    }
+
+    // Каждый язык в поле схемы принимает то же, что check_language
+    void languages() {
+        const inpch::language all[] = {inpch::rus, inpch::eng, inpch::RUS, inpch::ENG,
+                                       inpch::Rus, inpch::Eng, inpch::RuS, inpch::EnG};
+        const char *pieces[] = {"а", "я", "ё", "А", "Я", "Ё", "п", "Ж", "a", "z", "A", "Z", "1", " ", "\xD0",
+                                "\xD1\x80", "\xD0\x80", "\xC3\xA9"};
+        std::mt19937 rng(11);
+        for (inpch::language lang: all) {
+            const record_schema schema({field_rule().lang(lang)});
+            for (int i = 0; i < 20000; ++i) {
+                std::string field;
+                for (std::size_t n = 1 + rng() % 6; n > 0; --n) {
+                    // Чаще буквы, реже посторонние байты
+                    field += pieces[rng() % 4 ? rng() % 12 : rng() % std::size(pieces)];
+                }
+                const std::string_view row[] = {field};
+                const bool got = schema.validate(row, 1) == 1;
+                const bool want = inpch::check_language(field, lang).ok();
+                expect(got == want, "language " + std::to_string(lang) + " \"" + field + "\"");
+            }
+        }
+    }
+
+    void rows() {
+        const record_schema schema({
+                field_rule().base(inpch::decimal).length(3),
+                field_rule().lang(inpch::Rus).optional(),
+                field_rule().range(1, 100),
+                field_rule().date(inpch::date_format::iso_date),
+                field_rule().match(rgxp::dfa::email).optional(),
+        });
+        const field_mask all = schema.full_mask();
+        expect(all == 0x1F && schema.field_count() == 5, "full_mask");
+
+        expect(schema.validate_line("123,Привет,50,2024-02-29,a@b.cd") == all, "valid row");
+        expect(schema.accepts_line("123,Привет,50,2024-02-29,a@b.cd"), "accepts valid row");
+        expect(schema.validate_line("123,привет,50,2024-02-30,a@b") == (all & ~0x02 & ~0x08 & ~0x10),
+               "invalid fields");
+
+        // Необязательные пустые поля проходят, обязательные - нет
+        expect(schema.validate_line("123,,50,2024-02-29,") == all, "empty optional fields");
+        expect(schema.accepts_line("123,,50,2024-02-29,"), "accepts empty optional fields");
+        expect(schema.validate_line(",Привет,,2024-02-29,a@b.cd") == (all & ~0x01 & ~0x04), "empty required fields");
+        expect(schema.validate_line(",,,,") == 0x12, "all fields empty");
+
+        // Короткая строка: недостающие поля отклонены, в том числе необязательные
+        expect(schema.validate_line("123,Привет") == 0x03, "short row");
+        expect(!schema.accepts_line("123,Привет,50,2024-02-29"), "accepts a short row");
+        expect(schema.validate_line("") == 0, "empty line");
+        const std::string_view row[] = {"123", "", "7"};
+        expect(schema.validate(row, 3) == 0x07 && !schema.accepts(row, 3), "validate short array");
+        expect(schema.validate(row, 0) == 0, "validate empty array");
+
+        // Лишние поля не проверяются, но accepts_line требует точного числа
+        expect(schema.validate_line("123,Привет,50,2024-02-29,a@b.cd,extra") == all, "long row");
+        expect(!schema.accepts_line("123,Привет,50,2024-02-29,a@b.cd,extra"), "accepts a long row");
+        expect(!schema.accepts_line("123,Привет,50,2024-02-29,a@b.cd,"), "accepts a trailing delimiter");
+        expect(schema.accepts_line("123;Привет;50;2024-02-29;a@b.cd", ';'), "other delimiter");
+        expect(!schema.accepts_line("123;Привет;50;2024-02-29;a@b.cd"), "wrong delimiter");
+    }
+
+    void split() {
+        std::string_view fields[3];
+        expect(inpch::split_fields("a,b,c,d,e", ',', fields, 3) == 5, "split count beyond capacity");
+        expect(fields[0] == "a" && fields[1] == "b" && fields[2] == "c", "split fields within capacity");
+
+        std::string_view untouched[1] = {"keep"};
+        expect(inpch::split_fields("x,y", ',', untouched, 0) == 2 && untouched[0] == "keep", "split capacity 0");
+
+        expect(inpch::split_fields("", ',', fields, 3) == 1 && fields[0].empty(), "split empty line");
+        expect(inpch::split_fields("a,", ',', fields, 3) == 2 && fields[0] == "a" && fields[1].empty(),
+               "split trailing delimiter");
+        expect(inpch::split_fields(",,", ',', fields, 3) == 3 && fields[2].empty(), "split only delimiters");
+    }
+
+    void limits() {
+        const std::vector<field_rule> widest(record_schema::max_fields, field_rule().base(inpch::binary));
+        const record_schema schema(widest);
+        expect(schema.full_mask() == ~field_mask{0}, "full_mask of max_fields");
+        std::string line(2 * record_schema::max_fields - 1, ',');
+        for (std::size_t i = 0; i < line.size(); i += 2) line[i] = '1';
+        expect(schema.accepts_line(line), "row of max_fields");
+        line[line.size() - 1] = '2';
+        expect(schema.validate_line(line) == ~field_mask{0} >> 1, "last of max_fields");
+
+        bool thrown = false;
+        try {
+            record_schema too_wide(std::vector<field_rule>(record_schema::max_fields + 1));
+        } catch (const std::length_error &) {
+            thrown = true;
+        }
+        expect(thrown, "more than max_fields");
+    }
+
+} // namespace
+
+int main() {
+    languages();
+    rows();
+    split();
+    limits();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "record_schema_test: %zu failures\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+// result_cache: несколько потоков читают и вытесняют записи одних и тех же наборов,
+// каждый ответ кэша сверяется с прямой проверкой. Отдельно - обход кэша для длинных
+// входов, допуск cache_admission::repeated, CLOCK внутри набора и счётчики.
+//
+// ThreadSanitizer не моделирует atomic_thread_fence в seqlock, поэтому гонки здесь
+// ищутся по результату: устаревшая или разорванная запись дала бы чужой вердикт.
+
+#include "input_check.h"
+#include "result_cache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using inpch::check_result;
+    using inpch::result_cache;
+
+    std::atomic<std::size_t> failures{0};
+
+    void fail(const char *what) {
+        if (failures.fetch_add(1) < 20) std::fprintf(stderr, "%s\n", what);
+    }
+
+    bool same(const check_result &a, const check_result &b) {
+        return a.position == b.position && a.error == b.error;
+    }
+
+    // Ключи с общими префиксами и длинами около границ слов, чтобы записи
+    // отличались немногими байтами
+    std::vector<std::string> make_keys(std::size_t count, std::size_t min_size, std::size_t max_size,
+                                       std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::string> keys;
+        while (keys.size() < count) {
+            std::string s(min_size + rng() % (max_size - min_size + 1), '0');
+            for (auto &c: s) c = "0123456789abcdefx"[rng() % 17];
+            keys.push_back(std::move(s));
+        }
+        return keys;
+    }
+
+    // Три проверки с разными spec_id; у одних и тех же байтов разные ответы
+    struct spec_case {
+        result_cache::spec_id id;
+        inpch::base_type base;
+    };
+
+    const spec_case specs[] = {{result_cache::spec_of_text("decimal"), inpch::decimal},
+                               {result_cache::spec_of_text("hexadecimal"), inpch::hexadecimal},
+                               {result_cache::spec_of_text("binary"), inpch::binary}};
+
+    check_result direct(const spec_case &spec, const std::string &key) {
+        return inpch::check_base(key, inpch::any_length, spec.base);
+    }
+
+    // Ключи одной длины опаснее всего: разорванное чтение записи такой же длины
+    // прошло бы сравнение длины
+    void stress(const inpch::result_cache_options &options, std::size_t min_size, std::size_t max_size,
+                std::size_t threads, std::size_t rounds) {
+        result_cache cache(options);
+        const auto keys = make_keys(3000, min_size, max_size, 20);
+        std::atomic<std::uint64_t> lookups{0};
+        std::vector<std::thread> pool;
+        for (std::size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                std::mt19937 rng(static_cast<std::uint32_t>(t));
+                std::uint64_t local = 0;
+                for (std::size_t i = 0; i < rounds; ++i) {
+                    // Частые ключи в начале набора, как в реальных данных
+                    const std::size_t k = rng() % 4 ? rng() % 64 : rng() % keys.size();
+                    const spec_case &spec = specs[rng() % std::size(specs)];
+                    const std::string &key = keys[k];
+                    const check_result want = direct(spec, key);
+                    check_result got;
+                    switch (rng() % 4) {
+                        case 0:
+                            if (cache.find(spec.id, key, got) && !same(got, want)) fail("find returned a stale verdict");
+                            break;
+                        case 1:
+                            cache.insert(spec.id, key, want);
+                            continue;
+                        default:
+                            got = cache.get_or_check(spec.id, key, [&] { return want; });
+                            if (!same(got, want)) fail("get_or_check returned a wrong verdict");
+                            break;
+                    }
+                    ++local;
+                }
+                lookups.fetch_add(local);
+            });
+        }
+        for (auto &t: pool) t.join();
+
+        const inpch::result_cache_stats stats = cache.stats();
+        if (stats.hits + stats.misses != lookups.load()) fail("hits + misses differ from the number of lookups");
+        if (stats.size > stats.capacity) fail("size exceeds capacity");
+        if (stats.insertions != stats.size + stats.evictions) fail("insertions != size + evictions");
+        if (stats.bypassed != 0 || stats.rejected != 0) fail("unexpected bypassed or rejected");
+    }
+
+    void bypass() {
+        inpch::result_cache_options options;
+        options.max_input = 16;
+        result_cache cache(options);
+        const std::string longer(17, '7'), fits(16, '7');
+        int calls = 0;
+        for (int i = 0; i < 3; ++i) {
+            cache.get_or_check(specs[0].id, longer, [&] { ++calls; return check_result{17, inpch::check_error::none}; });
+        }
+        if (calls != 3) fail("long input served from the cache");
+        cache.insert(specs[0].id, longer, {0, inpch::check_error::wrong_character});
+        check_result got;
+        if (cache.find(specs[0].id, longer, got)) fail("long input found in the cache");
+
+        for (int i = 0; i < 3; ++i) {
+            cache.get_or_check(specs[0].id, fits, [&] { ++calls; return check_result{16, inpch::check_error::none}; });
+        }
+        if (calls != 4) fail("input of max_input bytes not cached");
+
+        const inpch::result_cache_stats stats = cache.stats();
+        if (stats.bypassed != 3 || stats.size != 1 || stats.hits != 2 || stats.misses != 1) {
+            fail("wrong statistics for bypassed inputs");
+        }
+    }
+
+    void admission() {
+        inpch::result_cache_options options;
+        options.admission = inpch::cache_admission::repeated;
+        result_cache cache(options);
+        const auto keys = make_keys(1000, 0, 30, 7);
+        std::vector<std::string> distinct;
+        for (std::size_t i = 0; i < keys.size(); ++i) distinct.push_back(keys[i] + "#" + std::to_string(i));
+
+        auto pass = [&] {
+            for (const auto &key: distinct) {
+                const check_result want = direct(specs[0], key);
+                if (!same(cache.get_or_check(specs[0].id, key, [&] { return want; }), want)) {
+                    fail("wrong verdict with repeated admission");
+                }
+            }
+        };
+        // Разовые значения не занимают места
+        pass();
+        inpch::result_cache_stats stats = cache.stats();
+        if (stats.insertions != 0 || stats.size != 0 || stats.rejected != distinct.size()) {
+            fail("one-off keys were admitted");
+        }
+        // Второе обращение допускает, третье попадает
+        pass();
+        stats = cache.stats();
+        if (stats.insertions != distinct.size()) fail("repeated keys were not admitted");
+        pass();
+        stats = cache.stats();
+        if (stats.hits != distinct.size()) fail("admitted keys were not found");
+
+        // clear сбрасывает и привратник
+        cache.clear();
+        pass();
+        if (cache.stats().size != 0) fail("clear kept the doorkeeper");
+    }
+
+    // Один набор: значения, к которым обращаются, CLOCK не вытесняет
+    void clock_eviction() {
+        inpch::result_cache_options options;
+        options.capacity = result_cache::set_ways;
+        options.shard_count = 1;
+        result_cache cache(options);
+        auto keys = make_keys(200, 0, 12, 3);
+        for (std::size_t i = 0; i < keys.size(); ++i) keys[i] += "#" + std::to_string(i);
+        const std::size_t hot = result_cache::set_ways / 2;
+        for (std::size_t i = 0; i < result_cache::set_ways; ++i) cache.insert(specs[0].id, keys[i], {i, {}});
+
+        check_result got;
+        for (std::size_t next = result_cache::set_ways; next < keys.size(); ++next) {
+            for (std::size_t i = 0; i < hot; ++i) {
+                if (!cache.find(specs[0].id, keys[i], got) || got.position != i) {
+                    fail("referenced entry was evicted");
+                    return;
+                }
+            }
+            // Новая запись без флага обращения; find здесь поставил бы его
+            cache.insert(specs[0].id, keys[next], {next, {}});
+        }
+        if (!cache.find(specs[0].id, keys.back(), got) || got.position != keys.size() - 1) fail("new entry is missing");
+        const inpch::result_cache_stats stats = cache.stats();
+        if (stats.size != result_cache::set_ways || stats.evictions != keys.size() - result_cache::set_ways) {
+            fail("wrong eviction count");
+        }
+    }
+
+} // namespace
+
+int main() {
+    // Маленький кэш: записи всё время вытесняются, потоки пишут в те же наборы, что читают
+    stress({result_cache::set_ways, 1, 64, inpch::cache_admission::always}, 12, 12, 4, 200000);
+    stress({256, 4, 64, inpch::cache_admission::always}, 0, 40, 4, 200000);
+    stress({1u << 14, 16, 64, inpch::cache_admission::always}, 0, 64, 3, 100000);
+    bypass();
+    admission();
+    clock_eviction();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "result_cache_test: %zu failures\n", failures.load());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+// Ядра input_simd на каждом доступном наборе инструкций против скалярного пути:
+// одинаковые входы со случайными длинами, смещениями и положением чужого символа.
+
+#include "input_simd.h"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace inpch::simd;
+
+namespace {
+
+    template<class Unit>
+    std::vector<Unit> random_units(std::mt19937 &rng, const std::vector<char32_t> &alphabet, std::size_t size) {
+        std::vector<Unit> units(size);
+        for (auto &unit: units) unit = static_cast<Unit>(alphabet[rng() % alphabet.size()]);
+        return units;
+    }
+
+    const byte_class byte_classes[] = {byte_class::binary, byte_class::octal, byte_class::decimal,
+                                       byte_class::hexadecimal, byte_class::lower, byte_class::upper,
+                                       byte_class::alpha};
+
+    const cyrillic_class cyrillic_classes[] = {cyrillic_class::lower, cyrillic_class::upper, cyrillic_class::alpha};
+
+    // Символы классов и их соседи по таблице, чтобы задеть границы диапазонов
+    const std::vector<char32_t> ascii = {U'/', U'0', U'1', U'7', U'8', U'9', U':', U'@', U'A', U'F', U'G', U'Z',
+                                         U'[', U'`', U'a', U'f', U'g', U'z', U'{', U' '};
+
+    const std::vector<char32_t> wide = {U'0', U'9', U'a', U'Z', U'а', U'я', U'ё', U'А', U'Я', U'Ё', U'Ѐ', U'ѐ',
+                                        U'\x0130', U'\x0161', U'\xD800', U'\x10030', U'\x1000A'};
+
+    const char *const cyrillic_words[] = {"а", "я", "ё", "А", "Я", "Ё", "\xD0", "\xD1\x91", "\xD0\x80", "z"};
+
+    // Результаты всех ядер на одном наборе входов, в порядке вызова
+    template<class Unit>
+    void wide_kernels(std::vector<std::size_t> &out, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 400; ++i) {
+            auto units = random_units<Unit>(rng, rng() % 2 ? wide : ascii, rng() % 150);
+            const std::size_t skip = units.empty() ? 0 : rng() % 4 % units.size();
+            const Unit *data = units.data() + skip;
+            const std::size_t size = units.size() - skip;
+            for (byte_class cls: byte_classes) {
+                out.push_back(first_not_of(data, size, cls));
+                out.push_back(first_of(data, size, cls));
+            }
+            for (cyrillic_class cls: cyrillic_classes) {
+                out.push_back(first_not_cyrillic(data, size, cls));
+                out.push_back(first_cyrillic(data, size, cls));
+            }
+        }
+    }
+
+    void byte_kernels(std::vector<std::size_t> &out, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 2000; ++i) {
+            const byte_class cls = byte_classes[rng() % std::size(byte_classes)];
+            // Строка целиком из класса, кроме одного чужого символа в случайном месте
+            std::string s;
+            const std::size_t size = rng() % 200;
+            while (s.size() < size) {
+                const char ch = static_cast<char>(ascii[rng() % ascii.size()]);
+                if (in_class(static_cast<unsigned char>(ch), cls)) s += ch;
+            }
+            if (!s.empty() && rng() % 2) s[rng() % s.size()] = static_cast<char>(rng() % 256);
+            const std::size_t skip = s.empty() ? 0 : rng() % 4 % s.size();
+            out.push_back(first_not_of(s.data() + skip, s.size() - skip, cls));
+
+            std::string word;
+            const std::size_t letters = rng() % 80;
+            for (std::size_t k = 0; k < letters; ++k) word += cyrillic_words[rng() % 6];
+            if (!word.empty() && rng() % 2) {
+                word.insert(rng() % word.size(), cyrillic_words[rng() % std::size(cyrillic_words)]);
+            }
+            for (cyrillic_class c: cyrillic_classes) out.push_back(first_not_cyrillic(word.data(), word.size(), c));
+        }
+    }
+
+    template<class T>
+    void range_kernels(std::vector<std::size_t> &out, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 300; ++i) {
+            std::vector<T> values(rng() % 300);
+            for (auto &v: values) v = static_cast<T>(static_cast<int>(rng() % 200) - 100);
+            if constexpr (std::is_floating_point<T>::value) {
+                for (auto &v: values) {
+                    if (rng() % 8 == 0) v = std::numeric_limits<T>::quiet_NaN();
+                }
+            }
+            const T left = static_cast<T>(static_cast<int>(rng() % 200) - 100);
+            const T right = static_cast<T>(left + static_cast<T>(rng() % 100));
+            const bool inside = rng() % 2;
+            const bool accept_nan = rng() % 2;
+
+            std::vector<std::uint64_t> words((values.size() + 63) / 64);
+            range_mask(values.data(), values.size(), left, right, inside, accept_nan, words.data());
+            // Биты за count не определены
+            if (values.size() % 64) words.back() &= (std::uint64_t(1) << values.size() % 64) - 1;
+            for (std::uint64_t w: words) out.push_back(static_cast<std::size_t>(w));
+
+            std::vector<std::uint32_t> indices(values.size());
+            const std::size_t n = range_indices(values.data(), values.size(), left, right, inside, accept_nan,
+                                                7, indices.data());
+            out.push_back(n);
+            out.insert(out.end(), indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(n));
+        }
+    }
+
+    struct kernel_set {
+        const char *name;
+        void (*run)(std::vector<std::size_t> &, std::uint32_t);
+    };
+
+    const kernel_set kernels[] = {
+            {"first_not_of/first_not_cyrillic", byte_kernels},
+            {"wide wchar_t", wide_kernels<wchar_t>},
+            {"wide char16_t", wide_kernels<char16_t>},
+            {"wide char32_t", wide_kernels<char32_t>},
+            {"range int", range_kernels<int>},
+            {"range long long", range_kernels<long long>},
+            {"range float", range_kernels<float>},
+            {"range double", range_kernels<double>},
+    };
+
+} // namespace
+
+int main() {
+    const isa levels[] = {isa::sse2, isa::avx2, isa::avx512};
+    std::size_t failures = 0;
+    for (const kernel_set &kernel: kernels) {
+        set_isa(isa::scalar);
+        std::vector<std::size_t> scalar;
+        kernel.run(scalar, 77);
+        for (isa level: levels) {
+            if (level > detected_isa()) break;
+            set_isa(level);
+            std::vector<std::size_t> got;
+            kernel.run(got, 77);
+            if (got != scalar) {
+                std::size_t at = 0;
+                while (at < got.size() && at < scalar.size() && got[at] == scalar[at]) ++at;
+                std::fprintf(stderr, "%s on %s differs from scalar at result %zu\n", kernel.name, isa_name(level), at);
+                ++failures;
+            }
+        }
+    }
+    set_isa(detected_isa());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "simd_test: %zu kernel sets differ\n", failures);
+        return 1;
+    }
+    std::printf("simd_test: checked up to %s\n", isa_name(detected_isa()));
+    return 0;
+}
@@ -0,0 +1,174 @@
+// static_check: пример из заголовка и остальные сочетания параметров проверяются
+// static_assert; затем для каждого сочетания результаты скалярного пути в
+// константном выражении сравниваются с путём через input_simd во время выполнения
+// и с check_base/check_language на узких (UTF-8) и широких строках.
+
+#include "static_check.h"
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace inpch;
+
+// Пример из комментария к static_check
+static_assert(static_check<policy::lang<Eng>>::test("Hello"));
+static_assert(!static_check<policy::lang<Eng>>::test("hello"));
+static_assert(!static_check<policy::lang<Eng>>::test("HEllo"));
+
+static_assert(static_check<policy::lang<eng>>::test("hello"));
+static_assert(static_check<policy::lang<ENG>>::test("HELLO"));
+static_assert(static_check<policy::lang<EnG>>::test("HeLLo"));
+static_assert(!static_check<policy::lang<EnG>>::test("He11o"));
+static_assert(static_check<policy::lang<rus>>::test("привет"));
+static_assert(static_check<policy::lang<RUS>>::test("ПРИВЕТ"));
+static_assert(static_check<policy::lang<Rus>>::test("Привет"));
+static_assert(static_check<policy::lang<Rus>>::test("Ёжик"));
+static_assert(!static_check<policy::lang<Rus>>::test("привет"));
+static_assert(!static_check<policy::lang<Rus>>::test("ПРивет"));
+static_assert(static_check<policy::lang<RuS>>::test("ПрИвЕт"));
+static_assert(!static_check<policy::lang<RuS>>::test("Привет!"));
+static_assert(static_check<policy::lang<Rus>>::test(L"Привет"));
+static_assert(static_check<policy::lang<RuS>>::test(U"пРИВЕт"));
+static_assert(!static_check<policy::lang<rus>>::test(u"прUвет"));
+
+static_assert(static_check<policy::length<6>, policy::base<hexadecimal>>::test("00ff9A"));
+static_assert(!static_check<policy::length<6>, policy::base<hexadecimal>>::test("00ff9"));
+static_assert(static_check<policy::base<decimal>>::test("-123"));
+static_assert(!static_check<policy::base<octal>>::test("-123"));
+static_assert(static_check<policy::base<binary>, policy::length<4>>::test(L"1010"));
+static_assert(static_check<policy::length<3>>::test("any"));
+
+// Позиция и вид ошибки
+static_assert(static_check<policy::base<decimal>>::check("+12a").position == 3);
+static_assert(static_check<policy::base<decimal>>::check("+").error == check_error::wrong_character);
+static_assert(static_check<policy::lang<Rus>>::check("Пр1вет").position == 4);
+static_assert(static_check<policy::lang<Rus>>::check("привет").position == 0);
+static_assert(static_check<policy::length<4>, policy::lang<eng>>::check("abcdef").error == check_error::wrong_length);
+static_assert(static_check<policy::length<4>, policy::lang<eng>>::check("abcdef").position == 4);
+static_assert(static_check<policy::lang<eng>>::check("").error == check_error::empty_input);
+
+namespace {
+
+    std::size_t failures = 0;
+
+    constexpr std::string_view narrow[] = {
+            "", "0", "1", "7", "9", "a", "f", "g", "Z", "+", "-", "+0", "-19", "+-1", "1010", "0777", "0x1F", "00ff9A",
+            "hello", "Hello", "HELLO", "HeLLo", "hEllo", "héllo", "abc1", "Привет", "привет", "ПРИВЕТ", "ПрИвЕт",
+            "Ёлка", "ёлка", "Ё", "ё", "П", "\xD0", "При\xD0", "Прuвет", "Пр ивет", "ПРивет", "аЯ", "Яа"};
+
+    constexpr std::wstring_view wide[] = {
+            L"", L"0", L"1", L"-19", L"0777", L"00ff9A", L"hello", L"Hello", L"HELLO", L"HeLLo", L"Привет",
+            L"привет", L"ПРИВЕТ", L"ПрИвЕт", L"Ёлка", L"ёлка", L"Ё", L"Прuвет", L"ПРивет", L"Ѐ", L"\x0130"};
+
+    template<class S, class C, std::size_t N, std::size_t... I>
+    constexpr std::array<check_result, N> constant_results(const std::basic_string_view<C> (&samples)[N],
+                                                           std::index_sequence<I...>) {
+        return {S::check(samples[I])...};
+    }
+
+    // Ожидаемый результат по функциям input_check
+    template<class S, class C>
+    check_result reference(const std::basic_string<C> &input) {
+        if constexpr (S::has_lang) {
+            if (input.empty()) return {0, check_error::empty_input};
+            if constexpr (S::has_length) {
+                const auto expected = static_cast<std::size_t>(S::length);
+                if (input.size() != expected) {
+                    return {std::min(input.size(), expected), check_error::wrong_length};
+                }
+            }
+            return check_language(input, S::lang);
+        } else {
+            return check_base(input, S::length, S::base);
+        }
+    }
+
+    bool same(const check_result &a, const check_result &b) {
+        return a.error == b.error && (a.ok() || a.position == b.position);
+    }
+
+    template<class S, class C, std::size_t N>
+    void compare(const char *name, const std::basic_string_view<C> (&samples)[N],
+                 const std::array<check_result, N> &constant) {
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::basic_string<C> input(samples[i]);
+            const check_result runtime = S::check(input);
+            const check_result want = reference<S>(input);
+            if ((!same(constant[i], runtime) || !same(runtime, want)) && ++failures <= 20) {
+                std::fprintf(stderr, "%s, %s sample %zu: constant %d@%zu, run time %d@%zu, input_check %d@%zu\n", name,
+                             sizeof(C) == 1 ? "narrow" : "wide", i, static_cast<int>(constant[i].error),
+                             constant[i].position, static_cast<int>(runtime.error), runtime.position,
+                             static_cast<int>(want.error), want.position);
+            }
+        }
+    }
+
+    // Случайные строки длиннее ширины SIMD-регистров: путь во время выполнения
+    // против check_base/check_language
+    template<class S>
+    void random_compare(const char *name) {
+        const char *pieces[] = {"а", "я", "ё", "Ё", "П", "Я", "a", "z", "A", "Z", "0", "1", "7", "9", "f", "F"};
+        const wchar_t *wide_pieces[] = {L"а", L"я", L"ё", L"Ё", L"П", L"Я", L"a", L"z", L"A", L"Z", L"0", L"1",
+                                        L"7", L"9", L"f", L"F"};
+        std::mt19937 rng(17);
+        for (int i = 0; i < 3000; ++i) {
+            std::string input;
+            std::wstring wide_input;
+            const std::size_t base = rng() % std::size(pieces);
+            for (std::size_t n = rng() % 70; n > 0; --n) {
+                // Строка в основном из одного вида символов, чтобы часть входов проходила
+                const std::size_t k = rng() % 10 ? (base + rng() % 2) % std::size(pieces) : rng() % std::size(pieces);
+                input += pieces[k];
+                wide_input += wide_pieces[k];
+            }
+            const check_result got = S::check(input), want = reference<S>(input);
+            const check_result wide_got = S::check(wide_input), wide_want = reference<S>(wide_input);
+            if ((!same(got, want) || !same(wide_got, wide_want)) && ++failures <= 20) {
+                std::fprintf(stderr, "%s: random input \"%s\" differs from input_check\n", name, input.c_str());
+            }
+        }
+    }
+
+#define INPCH_COMPARE(...)                                                                                          \
+    do {                                                                                                            \
+        using S = static_check<__VA_ARGS__>;                                                                        \
+        constexpr auto narrow_results = constant_results<S>(narrow, std::make_index_sequence<std::size(narrow)>());  \
+        constexpr auto wide_results = constant_results<S>(wide, std::make_index_sequence<std::size(wide)>());        \
+        compare<S>(#__VA_ARGS__, narrow, narrow_results);                                                           \
+        compare<S>(#__VA_ARGS__, wide, wide_results);                                                               \
+        random_compare<S>(#__VA_ARGS__);                                                                            \
+    } while (false)
+
+} // namespace
+
+int main() {
+    INPCH_COMPARE(policy::length<2>);
+    INPCH_COMPARE(policy::base<not_a_number>);
+    INPCH_COMPARE(policy::base<decimal>);
+    INPCH_COMPARE(policy::base<octal>);
+    INPCH_COMPARE(policy::base<hexadecimal>);
+    INPCH_COMPARE(policy::base<binary>);
+    INPCH_COMPARE(policy::base<decimal>, policy::length<3>);
+    INPCH_COMPARE(policy::length<6>, policy::base<hexadecimal>);
+    INPCH_COMPARE(policy::lang<rus>);
+    INPCH_COMPARE(policy::lang<eng>);
+    INPCH_COMPARE(policy::lang<RUS>);
+    INPCH_COMPARE(policy::lang<ENG>);
+    INPCH_COMPARE(policy::lang<Rus>);
+    INPCH_COMPARE(policy::lang<Eng>);
+    INPCH_COMPARE(policy::lang<RuS>);
+    INPCH_COMPARE(policy::lang<EnG>);
+    INPCH_COMPARE(policy::lang<Rus>, policy::length<12>);
+    INPCH_COMPARE(policy::length<4>, policy::lang<RuS>);
+    INPCH_COMPARE(policy::lang<Eng>, policy::length<5>);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "static_check_test: %zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
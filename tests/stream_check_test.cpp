@@ -0,0 +1,103 @@
+// stream_check против проверок целой строки: поле приходит частями случайного
+// размера из подставного сокета. Вердикт (принято или нет) должен совпадать
+// всегда; без заданной длины совпадают и ошибка, и её позиция.
+
+#include "stream_check.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace {
+
+    // Сокет в памяти: отдаёт байты строки частями от 0 до max_chunk байтов
+    class fake_socket {
+    public:
+        fake_socket(std::string_view data, std::mt19937 &rng, std::size_t max_chunk)
+                : data(data), rng(rng), max_chunk(max_chunk) {}
+
+        bool closed() const noexcept { return at == data.size(); }
+
+        std::string_view receive() {
+            std::size_t size = std::min<std::size_t>(rng() % (max_chunk + 1), data.size() - at);
+            std::string_view chunk = data.substr(at, size);
+            at += size;
+            return chunk;
+        }
+
+    private:
+        std::string_view data;
+        std::mt19937 &rng;
+        std::size_t max_chunk;
+        std::size_t at = 0;
+    };
+
+    std::size_t failures = 0;
+
+    inpch::check_result stream(inpch::stream_check &check, const std::string &input, std::mt19937 &rng) {
+        check.reset();
+        fake_socket socket(input, rng, 1 + rng() % 8);
+        while (!socket.closed() && check.feed(socket.receive())) {}
+        return check.finish();
+    }
+
+    void expect(const char *what, const std::string &input, inpch::check_result got, inpch::check_result want,
+                bool exact) {
+        bool same = got.ok() == want.ok() && (!exact || (got.error == want.error && got.position == want.position));
+        if (same) return;
+        if (++failures <= 10) {
+            std::fprintf(stderr, "%s \"%s\": stream %d@%zu, whole %d@%zu\n", what, input.c_str(),
+                         static_cast<int>(got.error), got.position, static_cast<int>(want.error), want.position);
+        }
+    }
+
+    std::string random_input(std::mt19937 &rng, const char *alphabet) {
+        std::string s;
+        std::size_t length = rng() % 12;
+        std::size_t letters = std::char_traits<char>::length(alphabet);
+        for (std::size_t i = 0; i < length; ++i) s += alphabet[rng() % letters];
+        return s;
+    }
+
+} // namespace
+
+int main() {
+    using namespace inpch;
+    std::mt19937 rng(2024);
+
+    const base_type bases[] = {not_a_number, decimal, octal, hexadecimal, binary};
+    for (base_type base: bases) {
+        for (int length: {any_length, 0, 1, 4, 7}) {
+            stream_check check(length, base);
+            for (int i = 0; i < 3000; ++i) {
+                std::string input = random_input(rng, "0123456789abcfXY+-");
+                expect("base", input, stream(check, input, rng), check_base(input, length, base),
+                       length == any_length);
+            }
+        }
+    }
+
+    const language languages[] = {rus, eng, RUS, ENG, Rus, Eng, RuS, EnG};
+    const char *words[] = {"привет", "Привет", "ПРИВЕТ", "hello", "Hello", "HELLO", "прИвет", "ёлка", "\xD0", "x"};
+    for (language lang: languages) {
+        stream_check check(lang);
+        for (int i = 0; i < 3000; ++i) {
+            std::string input;
+            for (std::size_t k = rng() % 3; k > 0; --k) input += words[rng() % std::size(words)];
+            expect("language", input, stream(check, input, rng), check_language(input, lang), true);
+        }
+    }
+
+    stream_check email(rgxp::dfa::email);
+    for (int i = 0; i < 3000; ++i) {
+        std::string input = random_input(rng, "ab.@c-om");
+        expect("email", input, stream(email, input, rng), check_match(input, rgxp::dfa::email.get()), false);
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "stream_check_test: %zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
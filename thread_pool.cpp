@@ -0,0 +1,128 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace inpch {
+
+    namespace {
+
+        thread_local const thread_pool *running_pool = nullptr;
+
+    } // namespace
+
+    thread_pool::thread_pool(std::size_t workers) {
+        // Последняя очередь принадлежит потоку, вызвавшему parallel_for
+        for (std::size_t i = 0; i <= workers; ++i) {
+            queues.push_back(std::make_unique<task_queue>());
+        }
+        threads.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            threads.emplace_back(&thread_pool::worker_loop, this, i);
+        }
+    }
+
+    thread_pool::~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &t: threads) t.join();
+    }
+
+    void thread_pool::parallel_for(std::size_t tasks, const std::function<void(std::size_t)> &body) {
+        if (tasks == 0) return;
+        if (tasks == 1 || threads.empty() || running_pool == this) {
+            for (std::size_t i = 0; i < tasks; ++i) body(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(submit_mutex);
+        job work;
+        work.body = &body;
+        work.remaining.store(tasks, std::memory_order_relaxed);
+
+        // Соседние задачи попадают в одну очередь: так потоки чаще идут по памяти подряд
+        const std::size_t n = queues.size();
+        for (std::size_t q = 0; q < n; ++q) {
+            std::size_t first = tasks * q / n, last = tasks * (q + 1) / n;
+            std::lock_guard<std::mutex> lock(queues[q]->mutex);
+            for (std::size_t i = first; i < last; ++i) queues[q]->tasks.push_back({&work, i});
+        }
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            ++generation;
+        }
+        wake.notify_all();
+
+        const thread_pool *outer = running_pool;
+        running_pool = this;
+        run_tasks(n - 1);
+        running_pool = outer;
+
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            done.wait(lock, [&work] { return work.remaining.load(std::memory_order_acquire) == 0; });
+        }
+        if (work.error) std::rethrow_exception(work.error);
+    }
+
+    void thread_pool::worker_loop(std::size_t self) {
+        running_pool = this;
+        std::uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(state_mutex);
+                wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            run_tasks(self);
+        }
+    }
+
+    void thread_pool::run_tasks(std::size_t self) {
+        task next{};
+        while (take(self, next)) {
+            job &work = *next.work;
+            try {
+                (*work.body)(next.index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(work.error_mutex);
+                if (!work.error) work.error = std::current_exception();
+            }
+            if (work.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                { std::lock_guard<std::mutex> lock(state_mutex); }
+                done.notify_all();
+            }
+        }
+    }
+
+    bool thread_pool::take(std::size_t self, task &next) {
+        {
+            task_queue &own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                next = own.tasks.front();
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < queues.size(); ++k) {
+            task_queue &victim = *queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                next = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    thread_pool &default_thread_pool() {
+        static thread_pool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return pool;
+    }
+
+} // inpch
@@ -0,0 +1,78 @@
+#ifndef INPUTCHECK_THREAD_POOL_H
+#define INPUTCHECK_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inpch {
+
+    // Пул потоков с перехватом работы: задачи раскладываются по очередям потоков,
+    // поток берёт задачи из начала своей очереди, а освободившись - из конца чужих
+    class thread_pool {
+    public:
+        // workers - число фоновых потоков; вызывающий поток работает вместе с ними
+        explicit thread_pool(std::size_t workers);
+
+        ~thread_pool();
+
+        thread_pool(const thread_pool &) = delete;
+
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        // Число потоков, выполняющих parallel_for, включая вызывающий
+        std::size_t concurrency() const noexcept { return queues.size(); }
+
+        // Выполняет body(i) для всех i из [0, tasks) и ждёт завершения.
+        // Первое исключение из body пробрасывается вызывающему. Вызов из задачи
+        // этого же пула выполняется последовательно в текущем потоке.
+        void parallel_for(std::size_t tasks, const std::function<void(std::size_t)> &body);
+
+    private:
+        struct job {
+            const std::function<void(std::size_t)> *body = nullptr;
+            std::atomic<std::size_t> remaining{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        struct task {
+            job *work;
+            std::size_t index;
+        };
+
+        struct alignas(64) task_queue {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+        std::vector<std::unique_ptr<task_queue>> queues;
+        std::vector<std::thread> threads;
+
+        std::mutex submit_mutex;
+        std::mutex state_mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::uint64_t generation = 0;
+        bool stopping = false;
+
+        void worker_loop(std::size_t self);
+
+        void run_tasks(std::size_t self);
+
+        bool take(std::size_t self, task &next);
+    };
+
+    // Общий пул на все ядра, создаётся при первом обращении
+    thread_pool &default_thread_pool();
+
+} // inpch
+
+#endif //INPUTCHECK_THREAD_POOL_H
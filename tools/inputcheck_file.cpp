@@ -0,0 +1,107 @@
+// Проверка каждой строки файла; выводит счётчики и позиции отклонённых строк.
+//
+//   inputcheck_file [--base dec|oct|hex|bin] [--length N] FILE
+//   inputcheck_file --lang rus|eng|RUS|ENG|Rus|Eng|RuS|EnG FILE
+//   inputcheck_file --pattern number|email|url|phone_number|hex FILE
+//   inputcheck_file --regex REGEX FILE
+//
+// Виды проверки друг друга исключают. Дополнительно: --max-rejects N ограничивает
+// список отклонённых строк.
+// Код возврата: 0 - все строки приняты, 1 - есть отклонённые, 2 - ошибка.
+
+#include "file_check.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace {
+
+    int usage() {
+        std::fputs("usage: inputcheck_file [--base dec|oct|hex|bin] [--length N] [--max-rejects N] FILE\n"
+                   "       inputcheck_file --lang L [--max-rejects N] FILE\n"
+                   "       inputcheck_file --pattern NAME [--max-rejects N] FILE\n"
+                   "       inputcheck_file --regex REGEX [--max-rejects N] FILE\n", stderr);
+        return 2;
+    }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    using namespace inpch;
+
+    const std::map<std::string, base_type> bases = {
+            {"dec", decimal}, {"oct", octal}, {"hex", hexadecimal}, {"bin", binary}};
+    const std::map<std::string, language> languages = {
+            {"rus", rus}, {"eng", eng}, {"RUS", RUS}, {"ENG", ENG},
+            {"Rus", Rus}, {"Eng", Eng}, {"RuS", RuS}, {"EnG", EnG}};
+    const std::map<std::string, const dfa_pattern *> patterns = {
+            {"number", &rgxp::dfa::number}, {"email", &rgxp::dfa::email}, {"url", &rgxp::dfa::url},
+            {"phone_number", &rgxp::dfa::phone_number}, {"hex", &rgxp::dfa::hex}};
+
+    int length = any_length;
+    base_type base = not_a_number;
+    bool by_number = false; // задан --base или --length
+    const language *lang = nullptr;
+    const dfa_pattern *pattern = nullptr;
+    std::unique_ptr<std::regex> regex;
+    file_check_options options;
+    const char *path = nullptr;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "--base" && has_value) {
+                auto it = bases.find(argv[++i]);
+                if (it == bases.end()) return usage();
+                base = it->second;
+                by_number = true;
+            } else if (arg == "--length" && has_value) {
+                length = std::stoi(argv[++i]);
+                by_number = true;
+            } else if (arg == "--lang" && has_value) {
+                auto it = languages.find(argv[++i]);
+                if (it == languages.end()) return usage();
+                lang = &it->second;
+            } else if (arg == "--pattern" && has_value) {
+                auto it = patterns.find(argv[++i]);
+                if (it == patterns.end()) return usage();
+                pattern = it->second;
+            } else if (arg == "--regex" && has_value) {
+                regex = std::make_unique<std::regex>(argv[++i]);
+            } else if (arg == "--max-rejects" && has_value) {
+                options.max_rejects = std::stoul(argv[++i]);
+            } else if (arg[0] != '-' && !path) {
+                path = argv[i];
+            } else {
+                return usage();
+            }
+        }
+        if (!path) return usage();
+        // Проверка одна: --base/--length, --lang, --pattern и --regex друг друга исключают
+        if (by_number + (lang != nullptr) + (pattern != nullptr) + (regex != nullptr) > 1) return usage();
+
+        check_spec spec = lang ? check_spec(*lang)
+                               : pattern ? check_spec(*pattern)
+                                         : regex ? check_spec(*regex)
+                                                 : check_spec(length, base);
+        file_report report = check_file(path, spec, options);
+
+        std::printf("lines %llu\naccepted %llu\nrejected %llu\n",
+                    static_cast<unsigned long long>(report.lines),
+                    static_cast<unsigned long long>(report.accepted),
+                    static_cast<unsigned long long>(report.rejected));
+        for (const auto &reject: report.rejects) {
+            std::printf("line %llu offset %llu\n",
+                        static_cast<unsigned long long>(reject.line),
+                        static_cast<unsigned long long>(reject.offset));
+        }
+        return report.rejected == 0 ? 0 : 1;
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "inputcheck_file: %s\n", e.what());
+        return 2;
+    }
+}
@@ -0,0 +1,208 @@
+#include "validation_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define INPCH_CPU_RELAX() _mm_pause()
+#else
+#define INPCH_CPU_RELAX() ((void) 0)
+#endif
+
+namespace inpch {
+
+    namespace {
+
+        // Ожидание соседней стороны очереди: сначала спин, потом уступаем ядро,
+        // потом спим, чтобы простаивающая стадия не занимала процессор
+        class backoff {
+        public:
+            void reset() noexcept { rounds = 0; }
+
+            void wait() {
+                if (rounds < 64) {
+                    INPCH_CPU_RELAX();
+                } else if (rounds < 128) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    return;
+                }
+                ++rounds;
+            }
+
+        private:
+            unsigned rounds = 0;
+        };
+
+        std::size_t in_flight(const pipeline_options &options) {
+            const std::size_t workers = std::max<std::size_t>(options.workers, 1);
+            return std::max<std::size_t>(options.batches_in_flight ? options.batches_in_flight : 4 * workers, 2);
+        }
+
+    } // namespace
+
+    validation_pipeline::validation_pipeline(const check_spec &spec, const pipeline_options &options)
+            : spec(spec),
+              batch_size(std::max<std::size_t>(options.batch_size, 1)),
+              work(in_flight(options)),
+              free_batches(in_flight(options)),
+              done(new std::atomic<batch *>[in_flight(options)]),
+              done_slots(in_flight(options)) {
+        for (std::size_t i = 0; i < done_slots; ++i) {
+            auto b = std::make_unique<batch>();
+            b->ends.reserve(batch_size);
+            b->bits.resize((batch_size + 63) / 64);
+            free_batches.try_push(b.get());
+            storage.push_back(std::move(b));
+            done[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        const std::size_t workers = std::max<std::size_t>(options.workers, 1);
+        try {
+            for (std::size_t i = 0; i < workers; ++i) threads.emplace_back([this] { worker_loop(); });
+        } catch (...) {
+            input_closed.store(true, std::memory_order_release);
+            for (auto &t: threads) t.join();
+            throw;
+        }
+    }
+
+    validation_pipeline::~validation_pipeline() {
+        close();
+        for (auto &t: threads) t.join();
+    }
+
+    bool validation_pipeline::acquire_batch(bool wait) {
+        if (filling) return true;
+        backoff pause;
+        while (!free_batches.try_pop(filling)) {
+            if (!wait) return false;
+            pause.wait();
+        }
+        filling->first = pushed;
+        filling->bytes.clear();
+        filling->ends.clear();
+        return true;
+    }
+
+    void validation_pipeline::submit(batch *b) {
+        b->sequence = next_sequence++;
+        // В очереди места на все пакеты, так что ожидания здесь не бывает
+        backoff pause;
+        while (!work.try_push(b)) pause.wait();
+    }
+
+    void validation_pipeline::push(std::string_view item) {
+        acquire_batch(true);
+        filling->bytes.append(item);
+        filling->ends.push_back(filling->bytes.size());
+        ++pushed;
+        if (filling->size() == batch_size) {
+            submit(filling);
+            filling = nullptr;
+        }
+    }
+
+    bool validation_pipeline::try_push(std::string_view item) {
+        if (!acquire_batch(false)) return false;
+        push(item);
+        return true;
+    }
+
+    void validation_pipeline::close() {
+        if (closed) return;
+        closed = true;
+        if (filling && filling->size() > 0) {
+            submit(filling);
+            filling = nullptr;
+        }
+        total_batches.store(next_sequence, std::memory_order_release);
+        input_closed.store(true, std::memory_order_release);
+    }
+
+    void validation_pipeline::worker_loop() {
+        backoff pause;
+        while (true) {
+            batch *b = nullptr;
+            if (!work.try_pop(b)) {
+                // Закрытие видно только после последнего пакета, поэтому после
+                // него очередь проверяется ещё раз
+                const bool last = input_closed.load(std::memory_order_acquire);
+                if (!work.try_pop(b)) {
+                    if (last) return;
+                    pause.wait();
+                    continue;
+                }
+            }
+            pause.reset();
+
+            for (std::size_t w = 0; w * 64 < b->size(); ++w) {
+                const std::size_t end = std::min(b->size(), (w + 1) * 64);
+                std::uint64_t word = 0;
+                for (std::size_t i = w * 64; i < end; ++i) {
+                    word |= static_cast<std::uint64_t>(spec(b->item(i))) << (i % 64);
+                }
+                b->bits[w] = word;
+            }
+            done[b->sequence % done_slots].store(b, std::memory_order_release);
+        }
+    }
+
+    bool validation_pipeline::next_batch() {
+        if (reading) {
+            // Места в очереди хватает на все пакеты
+            free_batches.try_push(reading);
+            reading = nullptr;
+        }
+        backoff pause;
+        while (true) {
+            std::atomic<batch *> &slot = done[next_to_read % done_slots];
+            batch *b = slot.load(std::memory_order_acquire);
+            if (b) {
+                slot.store(nullptr, std::memory_order_relaxed);
+                reading = b;
+                read_at = 0;
+                ++next_to_read;
+                return true;
+            }
+            if (next_to_read == total_batches.load(std::memory_order_acquire)) return false;
+            pause.wait();
+        }
+    }
+
+    bool validation_pipeline::pop(verdict &out) {
+        while (!reading || read_at == reading->size()) {
+            if (!next_batch()) return false;
+        }
+        out = {reading->first + read_at, static_cast<bool>((reading->bits[read_at / 64] >> (read_at % 64)) & 1u)};
+        ++read_at;
+        return true;
+    }
+
+    bool validation_pipeline::pop_accepted(std::string_view &item, std::uint64_t *index) {
+        while (true) {
+            while (!reading || read_at == reading->size()) {
+                if (!next_batch()) return false;
+            }
+            const std::size_t i = read_at++;
+            if ((reading->bits[i / 64] >> (i % 64)) & 1u) {
+                item = reading->item(i);
+                if (index) *index = reading->first + i;
+                return true;
+            }
+        }
+    }
+
+    bool validation_pipeline::pop_accepted(string_pool &out) {
+        while (!reading || read_at == reading->size()) {
+            if (!next_batch()) return false;
+        }
+        for (; read_at < reading->size(); ++read_at) {
+            if ((reading->bits[read_at / 64] >> (read_at % 64)) & 1u) out.append(reading->item(read_at));
+        }
+        return true;
+    }
+
+} // inpch
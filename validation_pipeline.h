@@ -0,0 +1,124 @@
+#ifndef INPUTCHECK_VALIDATION_PIPELINE_H
+#define INPUTCHECK_VALIDATION_PIPELINE_H
+
+#include "batch_check.h"
+#include "ring_queue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace inpch {
+
+    struct pipeline_options {
+        // Потоков проверки
+        std::size_t workers = 1;
+        // Элементов в пакете: очередь передаёт пакеты целиком, и синхронизация
+        // делится на все элементы пакета
+        std::size_t batch_size = 256;
+        // Пакетов в обработке одновременно (в очереди, у потоков проверки и у читателя
+        // результатов); когда все заняты, push ждёт. 0 - 4 на поток проверки
+        std::size_t batches_in_flight = 0;
+    };
+
+    struct verdict {
+        std::uint64_t index; // номер элемента в порядке push, начиная с 0
+        bool accepted;
+    };
+
+    // Стадия проверки между читателем и писателем: один поток подаёт элементы
+    // (push), пул потоков проверяет их по check_spec, один поток забирает
+    // результаты (pop, pop_accepted) в порядке подачи.
+    //
+    // Элементы копируются в пакеты, пакеты идут к потокам проверки через mpmc_ring
+    // и возвращаются пустыми подающему через spsc_ring. Готовый пакет кладётся в
+    // ячейку номер_пакета % batches_in_flight: пакетов в обработке не больше ячеек,
+    // поэтому ячейка к этому времени свободна, а забирающий ждёт следующий по
+    // порядку пакет в его ячейке. Ожидание - короткий спин, затем yield и sleep.
+    class validation_pipeline {
+    public:
+        validation_pipeline(const check_spec &spec, const pipeline_options &options = {});
+
+        // Закрывает вход, если close() не вызывался, и ждёт потоки проверки
+        ~validation_pipeline();
+
+        validation_pipeline(const validation_pipeline &) = delete;
+
+        validation_pipeline &operator=(const validation_pipeline &) = delete;
+
+        // Подающий поток. Ждёт, если все пакеты в обработке, пока забирающий поток
+        // не освободит пакет: подавать и забирать из одного потока нельзя
+        void push(std::string_view item);
+
+        // false вместо ожидания
+        bool try_push(std::string_view item);
+
+        // Отдаёт неполный пакет и закрывает вход; после этого push нельзя
+        void close();
+
+        // Забирающий поток. Ждёт следующий результат; false - вход закрыт и всё выдано
+        bool pop(verdict &out);
+
+        // Только принятые элементы; item действителен до следующего pop или pop_accepted
+        bool pop_accepted(std::string_view &item, std::uint64_t *index = nullptr);
+
+        // Принятые элементы следующего пакета (или остатка текущего) дописываются в out
+        // одним вызовом; false - вход закрыт и всё выдано
+        bool pop_accepted(string_pool &out);
+
+    private:
+        struct batch {
+            std::uint64_t sequence = 0;
+            std::uint64_t first = 0; // номер первого элемента
+            std::string bytes;
+            std::vector<std::size_t> ends;    // конец элемента i в bytes
+            std::vector<std::uint64_t> bits;  // бит i - элемент i принят
+
+            std::size_t size() const noexcept { return ends.size(); }
+
+            std::string_view item(std::size_t i) const noexcept {
+                std::size_t begin = i == 0 ? 0 : ends[i - 1];
+                return {bytes.data() + begin, ends[i] - begin};
+            }
+        };
+
+        check_spec spec;
+        std::size_t batch_size;
+        std::vector<std::unique_ptr<batch>> storage;
+        mpmc_ring<batch *> work;
+        spsc_ring<batch *> free_batches;
+        std::unique_ptr<std::atomic<batch *>[]> done; // по ячейке на пакет в обработке
+        std::size_t done_slots;
+        std::vector<std::thread> threads;
+
+        // Подающий поток
+        batch *filling = nullptr;
+        std::uint64_t pushed = 0;
+        std::uint64_t next_sequence = 0;
+        bool closed = false;
+
+        // Сколько пакетов всего; известно после close
+        std::atomic<std::uint64_t> total_batches{UINT64_MAX};
+        std::atomic<bool> input_closed{false};
+
+        // Забирающий поток
+        batch *reading = nullptr;
+        std::size_t read_at = 0;
+        std::uint64_t next_to_read = 0;
+
+        void worker_loop();
+
+        bool acquire_batch(bool wait);
+
+        void submit(batch *b);
+
+        bool next_batch();
+    };
+
+} // inpch
+
+#endif //INPUTCHECK_VALIDATION_PIPELINE_H